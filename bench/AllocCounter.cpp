@@ -0,0 +1,124 @@
+// Author: noapatito123@gmail.com
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::size_t> allocations{0}; // operator new calls so far
+    std::atomic<std::size_t> bytes{0};       // Bytes requested so far
+    thread_local coup::AllocScope *innermost = nullptr; // Scope charged for this thread's allocations
+}
+
+/**
+ * @brief Counting replacement of the global allocation function.
+ */
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    coup::AllocScope::on_allocation(size);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief Releases memory from the counting operator new.
+ */
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief Sized form of operator delete (the size is not needed).
+ */
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace coup
+{
+
+    /**
+     * @brief Number of operator new calls so far, over all threads.
+     */
+    std::size_t allocation_count()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bytes requested from operator new so far, over all threads.
+     */
+    std::size_t allocated_bytes()
+    {
+        return bytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Opens a scope on this thread; it becomes the innermost one.
+     * @param site Label of the guarded call site (a string literal).
+     */
+    AllocScope::AllocScope(const char *site) : site(site), outer(innermost)
+    {
+        innermost = this;
+    }
+
+    /**
+     * @brief Closes the scope if stop() was not called.
+     */
+    AllocScope::~AllocScope()
+    {
+        stop();
+    }
+
+    /**
+     * @brief Stops counting; the totals are added to the enclosing scope.
+     *
+     * Scopes must be stopped innermost first, as destructors do.
+     */
+    void AllocScope::stop()
+    {
+        if (!open)
+            return;
+        open = false;
+        innermost = outer;
+        if (outer)
+        {
+            outer->allocations += allocations;
+            outer->bytes += bytes;
+            if (outer->first_size == 0)
+                outer->first_size = first_size;
+        }
+    }
+
+    /**
+     * @brief Describes what the scope counted, for test failure messages.
+     * @return std::string e.g. "Governor::undo_tax: 2 allocations, 92 bytes (first: 46 bytes)".
+     */
+    std::string AllocScope::report() const
+    {
+        return std::string(site) + ": " + std::to_string(allocations) + " allocations, " +
+               std::to_string(bytes) + " bytes (first: " + std::to_string(first_size) + " bytes)";
+    }
+
+    /**
+     * @brief Charges one allocation to this thread's innermost scope, if any.
+     * @param size Bytes requested.
+     */
+    void AllocScope::on_allocation(std::size_t size)
+    {
+        AllocScope *scope = innermost;
+        if (!scope)
+            return;
+        if (scope->allocations == 0)
+            scope->first_size = size;
+        scope->allocations++;
+        scope->bytes += size;
+    }
+
+}
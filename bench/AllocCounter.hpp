@@ -0,0 +1,45 @@
+// Author: noapatito123@gmail.com
+// Heap allocation counters for benchmarks and allocation tests. Linking
+// AllocCounter.cpp replaces the global operator new/delete of the program
+// with counting versions.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace coup
+{
+
+    std::size_t allocation_count(); // operator new calls since the program started (all threads)
+    std::size_t allocated_bytes();  // Bytes requested from operator new since the program started (all threads)
+
+    // Counts the allocations made by this thread while it is alive, under a call-site label.
+    // Scopes nest: an allocation is charged to the innermost scope, and a closing scope
+    // passes its totals on to the enclosing one.
+    class AllocScope
+    {
+    private:
+        const char *site;            // Label of the guarded call site
+        AllocScope *outer;           // Enclosing scope on this thread (nullptr if none)
+        std::size_t allocations = 0; // Allocations charged to this scope
+        std::size_t bytes = 0;       // Bytes charged to this scope
+        std::size_t first_size = 0;  // Size of the first allocation (helps find it)
+        bool open = true;            // Still counting
+
+    public:
+        explicit AllocScope(const char *site); // Start counting on this thread
+        ~AllocScope();                         // Stop counting (if not stopped yet)
+        AllocScope(const AllocScope &) = delete;
+        AllocScope &operator=(const AllocScope &) = delete;
+
+        void stop(); // Stop counting and hand the totals to the enclosing scope
+
+        const char *get_site() const { return site; }         // Call-site label
+        std::size_t get_allocations() const { return allocations; } // Allocations so far
+        std::size_t get_bytes() const { return bytes; }             // Bytes so far
+        std::string report() const;                                 // "site: N allocations, B bytes (first: S bytes)"
+
+        static void on_allocation(std::size_t size); // Called by the counting operator new
+    };
+
+}
@@ -0,0 +1,204 @@
+// Author: noapatito123@gmail.com
+// Microbenchmarks of the core game operations for 2 to 6 players: mean and
+// percentile ns/op, plus heap allocations and bytes per op (global operator
+// new is replaced by AllocCounter.cpp to count them). Pass --csv for output that
+// can be saved and diffed between runs, or --check to fail when an operation
+// that should not allocate does.
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Governor.hpp"
+#include "RoleFactory.hpp"
+#include "AllocCounter.hpp"
+#include "Mcts.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // A seated table and the state every sample starts from
+    struct Table
+    {
+        Game game;
+        std::vector<std::shared_ptr<Player>> seats;
+        std::vector<std::string> names;
+        GameState root;
+
+        explicit Table(std::size_t players)
+        {
+            const RoleId roles[] = {RoleId::Governor, RoleId::Spy, RoleId::Baron,
+                                    RoleId::General, RoleId::Judge, RoleId::Merchant};
+            for (std::size_t i = 0; i < players; ++i)
+            {
+                names.push_back("Player" + std::to_string(i));
+                seats.push_back(create_player(game, roles[i % 6], names.back()));
+                game.add_player(seats.back());
+            }
+            root = game.get_state();
+        }
+
+        void reset(int coins = 0) // Back to the deal, every player holding `coins`
+        {
+            game.set_state(root);
+            if (coins > 0)
+                for (const auto &p : seats)
+                    p->increase_coins(coins);
+        }
+
+        Player &current() { return *game.get_current_player(); }
+        const std::shared_ptr<Player> &after(std::size_t k) { return seats[(game.get_turn_index() + k) % seats.size()]; }
+    };
+
+    // One benchmarked operation: setup (untimed) then `batch` timed calls form one sample
+    struct Op
+    {
+        const char *name;
+        std::size_t batch;  // Calls per sample (0: `rounds` calls per player)
+        std::size_t rounds; // Turns per player in a sample, few enough that the game stays legal
+        bool hot;           // Must not allocate (checked by --check)
+        void (*setup)(Table &);
+        void (*run)(Table &, std::size_t);
+    };
+
+    volatile std::uintptr_t sink; // Keeps results alive
+    SimRng playout_rng(1, 0);     // Same playouts on every run
+    const MctsConfig playout_config;
+
+    // A search playout: back to the deal, then the default rollout policy to the end
+    void playout(Table &t)
+    {
+        double rewards[kMaxPlayers];
+        t.game.set_state(t.root);
+        rollout(t.game, playout_rng, playout_config, rewards);
+        sink = static_cast<std::uintptr_t>(rewards[0] * 1024);
+    }
+
+    const Op kOps[] = {
+        {"next_turn", 64, 0, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { t.game.next_turn(); }},
+        {"get_player", 64, 0, true, [](Table &t) { t.reset(); },
+         [](Table &t, std::size_t i) { sink = reinterpret_cast<std::uintptr_t>(t.game.get_player(t.names[i % t.names.size()]).get()); }},
+        {"turn", 64, 0, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { sink = t.game.turn().size(); }},
+        {"legal_actions", 64, 0, true, [](Table &t) { t.reset(3); }, [](Table &t, std::size_t) { sink = t.game.legal_actions().count(); }},
+        {"gather", 0, 4, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { t.current().gather(); }},
+        {"tax", 0, 2, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { t.current().tax(); }},
+        {"arrest", 0, 2, true, [](Table &t) { t.reset(5); }, [](Table &t, std::size_t) { t.current().arrest(t.after(1)); }},
+        {"sanction", 0, 1, true, [](Table &t) { t.reset(5); }, [](Table &t, std::size_t) { t.current().sanction(t.after(1)); }},
+        {"coup", 1, 0, true, [](Table &t) { t.reset(7); }, [](Table &t, std::size_t) { t.current().coup(t.after(1)); }},
+        {"set_state", 64, 0, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { t.game.set_state(t.root); }},
+        {"playout", 1, 0, true, [](Table &t) { t.reset(); }, [](Table &t, std::size_t) { playout(t); }},
+        {"undo_tax", 1, 0, false,
+         [](Table &t) {
+             t.reset();
+             t.game.next_turn();
+             t.current().tax(); // Seat 1 taxes, the Governor (seat 0) undoes it
+         },
+         [](Table &t, std::size_t) { sink = static_cast<Governor &>(*t.seats[0]).undo_tax().size(); }}, // Builds a message
+    };
+
+    std::size_t batch_of(const Op &op, std::size_t players) { return op.batch ? op.batch : op.rounds * players; }
+
+    struct Result
+    {
+        double mean, p50, p90, p99; // ns/op
+        double allocs, bytes;       // Per op
+    };
+
+    // Median cost of an empty timed region, subtracted from every sample
+    double clock_overhead()
+    {
+        std::vector<double> v(1001);
+        for (double &x : v)
+        {
+            auto start = Clock::now();
+            x = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+        return v[v.size() / 2];
+    }
+
+    Result measure(const Op &op, std::size_t players, std::size_t samples, double overhead)
+    {
+        Table table(players);
+        const std::size_t batch = batch_of(op, players);
+        std::vector<double> per_op;
+        per_op.reserve(samples);
+        double total = 0;
+        std::size_t calls = 0, allocs = 0, bytes = 0;
+        for (std::size_t s = 0; s < samples + samples / 10; ++s) // The first tenth warms up
+        {
+            op.setup(table);
+            std::size_t a0 = allocation_count(), b0 = allocated_bytes();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < batch; ++i)
+                op.run(table, i);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() - overhead;
+            std::size_t a1 = allocation_count(), b1 = allocated_bytes();
+            if (s < samples / 10)
+                continue;
+            ns = std::max(ns, 0.0);
+            per_op.push_back(ns / batch);
+            total += ns;
+            calls += batch;
+            allocs += a1 - a0;
+            bytes += b1 - b0;
+        }
+        std::sort(per_op.begin(), per_op.end());
+        auto pct = [&per_op](std::size_t p) { return per_op[std::min(per_op.size() - 1, per_op.size() * p / 100)]; };
+        return Result{total / calls, pct(50), pct(90), pct(99),
+                      static_cast<double>(allocs) / calls, static_cast<double>(bytes) / calls};
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool csv = false;
+    bool check = false;
+    std::size_t samples = 2000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--csv") == 0)
+            csv = true;
+        else if (std::strcmp(argv[i], "--check") == 0)
+            check = true;
+        else
+            samples = std::max<std::size_t>(std::strtoul(argv[i], nullptr, 10), 10);
+    }
+
+    const double overhead = clock_overhead();
+    if (csv)
+        std::printf("op,players,batch,ns_per_op,p50_ns,p90_ns,p99_ns,allocs_per_op,bytes_per_op\n");
+    else
+        std::printf("%zu samples per row, clock overhead %.1f ns subtracted per sample\n\n%-14s %7s %9s %9s %9s %9s %9s %9s\n",
+                    samples, overhead, "op", "players", "ns/op", "p50", "p90", "p99", "allocs/op", "bytes/op");
+
+    int failures = 0;
+    for (const Op &op : kOps)
+    {
+        for (std::size_t players = 2; players <= kDefaultMaxPlayers; ++players)
+        {
+            Result r = measure(op, players, samples, overhead);
+            if (csv)
+                std::printf("%s,%zu,%zu,%.2f,%.2f,%.2f,%.2f,%.3f,%.1f\n", op.name, players, batch_of(op, players),
+                            r.mean, r.p50, r.p90, r.p99, r.allocs, r.bytes);
+            else
+                std::printf("%-14s %7zu %9.1f %9.1f %9.1f %9.1f %9.2f %9.1f\n", op.name, players,
+                            r.mean, r.p50, r.p90, r.p99, r.allocs, r.bytes);
+            if (check && op.hot && r.allocs > 0)
+            {
+                std::fprintf(stderr, "%s allocates with %zu players: %.3f allocations, %.1f bytes per call\n",
+                             op.name, players, r.allocs, r.bytes);
+                failures++;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+// Author: noapatito123@gmail.com
+// Turn-start cost of lifting sanctions: the original scan over every player
+// versus the per-sanctioner reverse index (bitmask) kept in GameState.
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Spy.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kSteps = 2000000;
+
+    // Player record as the original start_new_turn saw it
+    struct LegacyPlayer
+    {
+        std::string name;
+        bool eliminated = false;
+        bool sanctioned = false;
+        std::string sanctioned_by;
+    };
+
+    // Original algorithm: compare every player's sanctioner name with the current player's
+    double legacy_scan(std::size_t players)
+    {
+        std::vector<std::shared_ptr<LegacyPlayer>> table;
+        for (std::size_t i = 0; i < players; ++i)
+        {
+            auto p = std::make_shared<LegacyPlayer>();
+            p->name = "Player" + std::to_string(i);
+            table.push_back(p);
+        }
+        std::size_t cleared = 0;
+        auto start = Clock::now();
+        for (std::size_t step = 0; step < kSteps; ++step)
+        {
+            const LegacyPlayer &actor = *table[step % players];
+            for (const auto &p : table)
+            {
+                if (p->eliminated)
+                    continue;
+                if (p->sanctioned && p->sanctioned_by == actor.name)
+                {
+                    p->sanctioned = false;
+                    p->sanctioned_by.clear();
+                    cleared++;
+                }
+            }
+            LegacyPlayer &victim = *table[(step + 1 + step % 3) % players];
+            if (&victim != &actor)
+            {
+                victim.sanctioned = true;
+                victim.sanctioned_by = actor.name;
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kSteps;
+        return cleared ? ns : -1;
+    }
+
+    // Reverse index: each player keeps the mask of players they sanctioned
+    double reverse_index(std::size_t players)
+    {
+        std::vector<std::uint8_t> sanctioned(players, 0);
+        std::vector<PlayerMask> sanctions_by(players, 0);
+        PlayerMask alive = players == 64 ? ~PlayerMask(0) : (PlayerMask(1) << players) - 1;
+        std::size_t cleared = 0;
+        auto start = Clock::now();
+        for (std::size_t step = 0; step < kSteps; ++step)
+        {
+            PlayerId actor = static_cast<PlayerId>(step % players);
+            PlayerMask lifted = sanctions_by[actor] & alive;
+            sanctions_by[actor] &= ~lifted;
+            for (; lifted; lifted &= lifted - 1)
+            {
+                sanctioned[mask_first(lifted)] = 0;
+                cleared++;
+            }
+            PlayerId victim = static_cast<PlayerId>((step + 1 + step % 3) % players);
+            if (victim != actor)
+            {
+                sanctioned[victim] = 1;
+                sanctions_by[actor] |= player_bit(victim);
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kSteps;
+        return cleared ? ns : -1;
+    }
+
+    // Full Game::next_turn on a real table where every turn leaves a sanction behind
+    double game_next_turn(std::size_t players)
+    {
+        Game game(players);
+        std::vector<std::shared_ptr<Player>> seats;
+        for (std::size_t i = 0; i < players; ++i)
+        {
+            seats.push_back(std::make_shared<Spy>(game, "Player" + std::to_string(i)));
+            game.add_player(seats.back());
+        }
+        auto start = Clock::now();
+        for (std::size_t step = 0; step < kSteps; ++step)
+        {
+            PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+            PlayerId victim = static_cast<PlayerId>((actor + 1 + step % 3) % players);
+            if (victim != actor)
+                seats[victim]->mark_sanctioned(actor);
+            game.next_turn();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kSteps;
+    }
+}
+
+int main()
+{
+    const std::size_t counts[] = {2, 3, 4, 5, 6, 8, 16, 32, 64};
+    std::printf("%8s %14s %14s %10s %18s\n", "players", "scan ns/turn", "mask ns/turn", "speedup", "next_turn ns/turn");
+    for (std::size_t players : counts)
+    {
+        double scan = legacy_scan(players);
+        double mask = reverse_index(players);
+        std::printf("%8zu %14.2f %14.2f %9.1fx", players, scan, mask, mask > 0 ? scan / mask : 0.0);
+        std::printf(" %18.2f\n", game_next_turn(players));
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Author: noapatito123@gmail.com
+// Per-turn cost across table sizes, from 2 to 64 players. The turn bookkeeping
+// (next_turn, sanction and coup clearing, the round reset, name lookups) is kept
+// in per-player bitmasks and hash maps, so these columns should stay flat while
+// the table grows; only set_state, which copies the used seats, and self-play,
+// whose bots scan the table, may grow.
+// Pass --csv for output that can be saved and diffed between runs.
+#include "Game.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Spy.hpp"
+#include "SimEngine.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kSteps = 1 << 20; // Timed calls per cell (rounded up to whole chunks)
+
+    volatile std::uintptr_t sink; // Keeps results alive
+
+    // A table with every role, reset from its deal between timed chunks
+    struct Table
+    {
+        Game game;
+        std::vector<std::shared_ptr<Player>> seats;
+        std::vector<std::string> names;
+        GameState deal;
+
+        explicit Table(std::size_t players) : game(players)
+        {
+            const RoleId roles[] = {RoleId::Governor, RoleId::Spy, RoleId::Baron,
+                                    RoleId::General, RoleId::Judge, RoleId::Merchant};
+            for (std::size_t i = 0; i < players; ++i)
+            {
+                names.push_back("Player number " + std::to_string(i));
+                seats.push_back(create_player(game, roles[i % 6], names.back()));
+                game.add_player(seats.back());
+            }
+            deal = game.get_state();
+        }
+    };
+
+    // Marks a player's once-per-round ability as used (no-op for roles without one)
+    void spend_ability(Player &p)
+    {
+        switch (p.role_id())
+        {
+        case RoleId::Governor:
+            static_cast<Governor &>(p).mark_undo_tax_used();
+            break;
+        case RoleId::Judge:
+            static_cast<Judge &>(p).mark_undo_bribe_used();
+            break;
+        case RoleId::General:
+            static_cast<General &>(p).mark_undo_coup_used();
+            break;
+        case RoleId::Spy:
+            static_cast<Spy &>(p).mark_peek_and_disable_used();
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Runs `step` kSteps times in chunks of `chunk` calls; before each chunk the table is
+    // reset and `setup` runs, both untimed
+    template <typename Setup, typename Step>
+    double per_call(Table &table, std::size_t chunk, Setup setup, Step step)
+    {
+        double ns = 0;
+        std::size_t done = 0;
+        for (; done < kSteps; done += chunk)
+        {
+            table.game.set_state(table.deal);
+            setup();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < chunk; ++i)
+                step(done + i);
+            ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+        return ns / done;
+    }
+
+    template <typename Step>
+    double per_call(Table &table, std::size_t chunk, Step step)
+    {
+        return per_call(table, chunk, [] {}, step);
+    }
+
+    struct Row
+    {
+        double next_turn;   // Plain turn change
+        double bookkeeping; // Turn change that lifts a sanction and drops a coup record
+        double round_turn;  // Turn change in a round that starts with every ability spent
+        double gather;      // Player::gather (one full turn)
+        double get_player;  // Name lookup
+        double coup_list;   // is_in_coup_list by name
+        double set_state;   // Restoring a saved state (what search does before every playout)
+        double selfplay;    // Self-play actions, per action (bots scan the table)
+    };
+
+    Row measure(std::size_t players)
+    {
+        Table t(players);
+        Game &game = t.game;
+        Row row;
+
+        row.next_turn = per_call(t, 4096, [&](std::size_t) { game.next_turn(); });
+
+        row.bookkeeping = per_call(t, 4096, [&](std::size_t i) {
+            PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+            PlayerId victim = static_cast<PlayerId>((actor + 1 + i % 3) % players);
+            if (victim != actor)
+            {
+                t.seats[victim]->mark_sanctioned(actor);
+                game.add_to_coup(actor, victim); // Bookkeeping only: the victim stays in the game
+            }
+            game.next_turn();
+        });
+
+        row.round_turn = per_call(
+            t, players,
+            [&] {
+                for (const auto &p : t.seats)
+                    spend_ability(*p);
+            },
+            [&](std::size_t) { game.next_turn(); }); // The last call of each chunk starts the next round
+        row.gather = per_call(t, players * 4, [&](std::size_t) { game.get_current_player()->gather(); });
+        row.get_player = per_call(t, 4096, [&](std::size_t i) { sink = reinterpret_cast<std::uintptr_t>(game.get_player(t.names[i % players]).get()); });
+        row.coup_list = per_call(t, 4096, [&](std::size_t i) { sink = game.is_in_coup_list(t.names[i % players]); });
+        row.set_state = per_call(t, 4096, [&](std::size_t) { game.set_state(t.deal); });
+
+        SimConfig config;
+        config.games = 64 * 64 / players;
+        config.players = players;
+        config.max_turns = players * 200;
+        SimEngine engine(config);
+        SimStats stats = engine.run();
+        row.selfplay = stats.seconds * 1e9 / stats.actions;
+        return row;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool csv = argc > 1 && std::strcmp(argv[1], "--csv") == 0;
+    const std::size_t sizes[] = {2, 4, 6, 8, 16, 32, 64};
+    if (csv)
+        std::printf("players,next_turn_ns,bookkeeping_ns,round_turn_ns,gather_ns,get_player_ns,coup_list_ns,set_state_ns,selfplay_ns_per_action\n");
+    else
+        std::printf("ns per call\n%8s %10s %12s %12s %8s %11s %10s %10s %14s\n", "players", "next_turn", "bookkeeping",
+                    "round_turn", "gather", "get_player", "coup_list", "set_state", "selfplay/act");
+    for (std::size_t players : sizes)
+    {
+        Row r = measure(players);
+        if (csv)
+            std::printf("%zu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", players, r.next_turn, r.bookkeeping, r.round_turn,
+                        r.gather, r.get_player, r.coup_list, r.set_state, r.selfplay);
+        else
+            std::printf("%8zu %10.1f %12.1f %12.1f %8.1f %11.1f %10.1f %10.1f %14.1f\n", players, r.next_turn, r.bookkeeping,
+                        r.round_turn, r.gather, r.get_player, r.coup_list, r.set_state, r.selfplay);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Author: noapatito123@gmail.com
+// Self-play batch throughput on the work-stealing pool from 1 to N workers.
+// Every run must give the same stats, whatever the number of workers.
+#include "SimEngine.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    constexpr std::size_t kGames = 20000; // Games per run
+
+    bool same(const SimStats &a, const SimStats &b)
+    {
+        return a.games == b.games && a.draws == b.draws && a.actions == b.actions && a.wins == b.wins;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    max_threads = std::max<std::size_t>(max_threads, 1);
+
+    SimConfig config;
+    config.games = kGames;
+    config.players = 6;
+
+    std::vector<std::size_t> counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(max_threads);
+
+    std::printf("%zu games of %zu players, mixed random/greedy seats\n\n", config.games, config.players);
+    std::printf("%8s %10s %9s %8s %6s\n", "threads", "games/s", "speedup", "steals", "same");
+
+    SimStats reference;
+    double base = 0;
+    for (std::size_t threads : counts)
+    {
+        SimEngine engine(config);
+        for (std::size_t seat = 1; seat < engine.seats(); seat += 2)
+            engine.set_strategy(seat, std::make_shared<GreedyStrategy>());
+        WorkStealingPool pool(threads);
+        SimStats stats = engine.run(pool);
+        if (threads == 1)
+        {
+            reference = stats;
+            base = stats.games_per_second();
+        }
+        std::printf("%8zu %10.0f %8.2fx %8zu %6s\n", threads, stats.games_per_second(),
+                    stats.games_per_second() / base, pool.steals(), same(stats, reference) ? "yes" : "NO");
+        if (!same(stats, reference))
+            return 1;
+    }
+    return 0;
+}
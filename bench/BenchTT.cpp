@@ -0,0 +1,117 @@
+// Author: noapatito123@gmail.com
+// Throughput of the shared lock-free transposition table from 1 to N threads,
+// on position hashes collected by playing real games through the Player API.
+#include "Game.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "SimEngine.hpp"
+#include "Strategy.hpp"
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kGames = 3000;       // Games played to collect positions
+    constexpr std::size_t kOpsPerThread = 4000000; // Probes per thread and run
+    constexpr std::size_t kTableMegabytes = 64;
+
+    // Hash of every position reached by random self-play
+    std::vector<std::uint64_t> collect_positions()
+    {
+        std::vector<std::uint64_t> positions;
+        SimRng rng(7);
+        RandomStrategy strategy;
+        for (std::size_t g = 0; g < kGames; ++g)
+        {
+            Game game;
+            for (std::size_t seat = 0; seat < 6; ++seat)
+                game.add_player(create_player(game, static_cast<RoleId>(rng() % kRoleCount), "P" + std::to_string(seat)));
+            for (std::size_t turn = 0; turn < 1000 && !game.is_game_over(); ++turn)
+            {
+                PlayerId current = static_cast<PlayerId>(game.get_turn_index());
+                Action action = strategy.choose_action(game, current, rng);
+                action.actor = current;
+                if (!SimEngine::apply(game, action) && !SimEngine::apply(game, Action{ActionKind::Gather, current, kNoTarget}))
+                    game.next_turn();
+                positions.push_back(game.get_hash());
+            }
+        }
+        return positions;
+    }
+
+    // Each thread walks the positions from its own offset: probe, and store on a miss
+    double run(TranspositionTable &table, const std::vector<std::uint64_t> &positions, std::size_t threads)
+    {
+        std::vector<std::thread> workers;
+        auto start = Clock::now();
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&table, &positions, t, threads]() {
+                std::size_t index = t * positions.size() / threads;
+                for (std::size_t op = 0; op < kOpsPerThread; ++op)
+                {
+                    std::uint64_t key = positions[index];
+                    TTData data;
+                    if (!table.probe(key, data))
+                    {
+                        data.depth = static_cast<std::uint8_t>(op & 15);
+                        data.bound = TTBound::Exact;
+                        data.value = static_cast<std::int16_t>(key);
+                        table.store(key, data);
+                    }
+                    if (++index == positions.size())
+                        index = 0;
+                }
+            });
+        }
+        for (std::thread &worker : workers)
+            worker.join();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    max_threads = std::max<std::size_t>(max_threads, 1);
+
+    std::vector<std::uint64_t> positions = collect_positions();
+    std::vector<std::uint64_t> distinct = positions;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    std::printf("positions: %zu (%zu distinct) from %zu games\n", positions.size(), distinct.size(), kGames);
+
+    TranspositionTable table(kTableMegabytes);
+    std::printf("table:     %zu MB, %zu entries\n\n", table.size_bytes() >> 20, table.entry_count());
+    std::printf("%8s %12s %9s %10s %12s\n", "threads", "Mprobes/s", "speedup", "hit rate", "collisions");
+
+    std::vector<std::size_t> counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(max_threads);
+
+    double base = 0;
+    for (std::size_t threads : counts)
+    {
+        table.clear();
+        double seconds = run(table, positions, threads);
+        double rate = threads * kOpsPerThread / seconds / 1e6;
+        if (threads == 1)
+            base = rate;
+        TTStats stats = table.stats();
+        double probes = static_cast<double>(stats.hits + stats.misses);
+        std::printf("%8zu %12.1f %8.2fx %9.1f%% %12llu\n", threads, rate, rate / base,
+                    probes > 0 ? 100.0 * stats.hits / probes : 0.0, static_cast<unsigned long long>(stats.collisions));
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "GameState.hpp"
+
+namespace coup
+{
+
+    // Every move a player can make, including out-of-turn role abilities
+    enum class ActionKind : std::uint8_t
+    {
+        Gather,
+        Tax,
+        Bribe,
+        Invest,         // Baron only
+        Arrest,         // targeted
+        Sanction,       // targeted
+        Coup,           // targeted
+        UndoTax,        // Governor only, out of turn
+        UndoBribe,      // Judge only, out of turn (target is the current player)
+        UndoCoup,       // General only, targeted at an eliminated player
+        PeekAndDisable, // Spy only, targeted
+        Count
+    };
+
+    constexpr std::size_t kActionKindCount = static_cast<std::size_t>(ActionKind::Count);
+    constexpr PlayerId kNoTarget = kNoPlayer; // Target of untargeted actions
+
+    constexpr int kBribeCost = 4;      // Coins paid for a bribe
+    constexpr int kInvestCost = 3;     // Coins a Baron must hold (and gains) to invest
+    constexpr int kCoupCost = 7;       // Coins paid for a coup
+    constexpr int kUndoCoupCost = 5;   // Coins a General pays to undo a coup
+    constexpr int kMustCoupCoins = 10; // Coins at which a coup becomes mandatory
+
+    // Outcome of a try_* action; every failure matches one exception in exceptions.hpp
+    enum class ActionStatus : std::uint8_t
+    {
+        Ok,
+        GameNotStarted,          // GameNotStartedException
+        NotYourTurn,             // NotYourTurnException
+        MustCoup,                // MustPerformCoupException
+        Sanctioned,              // SanctionedException
+        NotEnoughCoins,          // NotEnoughCoinsException
+        ArrestBlocked,           // ArrestBlockedException
+        InvalidTarget,           // PlayerNotFoundException (target is not in this game)
+        CannotTargetYourself,    // CannotTargetYourselfException
+        TargetEliminated,        // TargetIsEliminatedException
+        TargetAlreadyEliminated, // TargetIsAlreadyEliminatedException
+        TargetNotEliminated,     // TargetNotEliminatedException
+        DuplicateArrest,         // DuplicateArrestException
+        TargetNoCoins,           // TargetNoCoinsException
+        AlreadySanctioned,       // AlreadySanctionedException
+        PlayerEliminated,        // PlayerEliminatedException (the actor is out)
+        AbilityUsed,             // ActionAlreadyUsedThisRoundException
+        NotUndoable,             // UndoNotAllowedException (target did not do it)
+        CannotUndoOwnAction,     // CannotUndoOwnActionException
+        ActionTooOld,            // ActionTooOldException
+        NoRecentAction,          // NoRecentActionToUndoException
+        NoCoupToUndo,            // NoCoupToUndoException
+        InvalidBribeUndo,        // InvalidBribeUndoException
+        Count
+    };
+
+    // A single move: who does what to whom
+    struct Action
+    {
+        ActionKind kind;
+        PlayerId actor;
+        PlayerId target;
+    };
+
+    // Set of (action, target) pairs one player may play: a mask of targets per action kind,
+    // plus one bit per kind for the untargeted form
+    class ActionSet
+    {
+    private:
+        PlayerMask targets[kActionKindCount] = {}; // Legal targets of each kind
+        std::uint16_t untargeted = 0;              // Bit k: kind k is legal without a target
+
+        static_assert(kActionKindCount <= 16, "untargeted needs a bit per action kind");
+
+    public:
+        void add(ActionKind kind, PlayerId target = kNoTarget) // Mark a pair legal
+        {
+            if (target == kNoTarget)
+                untargeted |= static_cast<std::uint16_t>(1u << static_cast<unsigned>(kind));
+            else
+                targets[static_cast<std::size_t>(kind)] |= player_bit(target);
+        }
+        bool allows(ActionKind kind, PlayerId target = kNoTarget) const // Is a pair legal
+        {
+            if (target == kNoTarget)
+                return (untargeted >> static_cast<unsigned>(kind)) & 1u;
+            return target < kMaxPlayers && (targets[static_cast<std::size_t>(kind)] & player_bit(target)) != 0;
+        }
+        bool any(ActionKind kind) const // Is the action legal against at least one target
+        {
+            return targets[static_cast<std::size_t>(kind)] != 0 || ((untargeted >> static_cast<unsigned>(kind)) & 1u);
+        }
+        bool empty() const // No legal action at all
+        {
+            for (PlayerMask mask : targets)
+                if (mask)
+                    return false;
+            return untargeted == 0;
+        }
+        std::size_t count() const // Number of legal pairs
+        {
+            std::size_t n = static_cast<std::size_t>(mask_count(untargeted));
+            for (PlayerMask mask : targets)
+                n += static_cast<std::size_t>(mask_count(mask));
+            return n;
+        }
+
+        template <typename Visitor>
+        void for_each(PlayerId actor, Visitor visit) const // Call visit(Action) for every legal pair, kind by kind, targets first
+        {
+            for (std::size_t kind = 0; kind < kActionKindCount; ++kind)
+            {
+                for (PlayerMask mask = targets[kind]; mask; mask &= mask - 1)
+                    visit(Action{static_cast<ActionKind>(kind), actor, mask_first(mask)});
+                if ((untargeted >> kind) & 1u)
+                    visit(Action{static_cast<ActionKind>(kind), actor, kNoTarget});
+            }
+        }
+    };
+
+    const char *action_name(ActionKind kind); // Human-readable action name
+    bool is_targeted(ActionKind kind);        // Does the action need a target
+    const char *status_name(ActionStatus status); // Short name of an action status
+}
@@ -0,0 +1,57 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Action.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace coup
+{
+
+    // One logged action
+    struct HistoryEntry
+    {
+        ActionKind kind;     // What was done
+        PlayerId actor;      // Who did it
+        PlayerId target;     // To whom (kNoTarget if untargeted)
+        std::int16_t amount; // Coins involved
+        std::uint32_t round; // Round it happened in
+        std::uint32_t turn;  // Global turn it happened in (Game::get_global_turn_index)
+    };
+
+    // Fixed-capacity log of the most recent actions; the oldest entry is overwritten when full.
+    // Evicted entries stay in storage for another kSlack pushes, so rewind() can take
+    // back the newest entries and bring the evicted ones back.
+    class ActionHistory
+    {
+    public:
+        static constexpr std::size_t kCapacity = 128; // Entries kept
+        static constexpr std::size_t kSlack = 128;    // Evicted entries rewind() can still restore
+        using SpillHook = std::function<void(const HistoryEntry &)>; // Receives entries as they are overwritten
+
+    private:
+        static constexpr std::size_t kStorage = kCapacity + kSlack; // Ring slots
+
+        std::array<HistoryEntry, kStorage> entries; // Ring storage, indexed by push number
+        std::size_t count = 0;                      // Entries in use
+        std::uint64_t total = 0;                    // Entries ever pushed
+        SpillHook spill;                            // Optional sink for evicted entries
+
+    public:
+        void push(const HistoryEntry &entry); // Append, evicting the oldest entry when full
+        void rewind(std::uint64_t to_total);  // Drop the entries pushed after the to_total-th (make/unmake search)
+        void clear();                         // Drop all entries (the spill hook is kept)
+        void set_spill_hook(SpillHook hook) { spill = std::move(hook); } // Install or remove (nullptr) the spill hook
+
+        std::size_t size() const { return count; }                 // Entries currently kept
+        bool empty() const { return count == 0; }                  // No entries kept
+        static constexpr std::size_t capacity() { return kCapacity; } // Maximum entries kept
+        std::uint64_t total_pushed() const { return total; }        // Entries ever pushed, including evicted ones
+
+        const HistoryEntry &operator[](std::size_t i) const { return entries[(total - count + i) % kStorage]; } // i-th oldest entry
+        const HistoryEntry &back() const { return (*this)[count - 1]; } // Newest entry
+    };
+
+}
@@ -11,6 +11,7 @@ private:
     sf::Text label;               // Text displayed on the button
     std::function<void()> action; // Action to perform when clicked
     std::string labelText;        // Text content of the label
+    bool enabled = true;          // Disabled buttons are greyed out and ignore clicks
 
 public:
     // Constructor to initialize button with text, font, size, and position
@@ -22,4 +23,6 @@ public:
     bool contains(float x, float y) const;      // Check if a point is inside the button
     void execute();                             // Execute the assigned action
     const std::string &getLabel() const;        // Get the label text
+    void setEnabled(bool value);                // Enable or grey out the button
+    bool isEnabled() const { return enabled; }  // Can the button be clicked
 };
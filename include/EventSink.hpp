@@ -0,0 +1,106 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Action.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace coup
+{
+
+    class Game;
+
+    // What happened; the first values match ActionKind one to one
+    enum class EventType : std::uint8_t
+    {
+        Gather,
+        Tax,
+        Bribe,
+        Invest,
+        Arrest,
+        Sanction,
+        Coup,
+        UndoTax,
+        UndoBribe,
+        UndoCoup,
+        PeekAndDisable,
+        ArrestUnblocked, // A player's arrest block expired
+        WinnerChanged,   // The winner changed (actor is the new winner, kNoPlayer once the game is open again)
+        TurnPassed,      // The current player had no legal move and passed (Game::pass_turn)
+        Count
+    };
+
+    static_assert(static_cast<int>(EventType::PeekAndDisable) == static_cast<int>(ActionKind::PeekAndDisable),
+                  "EventType must start with the ActionKind values");
+
+    // Structured record of one action, emitted by the rules
+    struct GameEvent
+    {
+        EventType type;     // What happened
+        PlayerId actor;     // Who did it
+        PlayerId target;    // To whom (kNoPlayer if untargeted)
+        std::int32_t amount; // Coins involved (gained, paid, removed or peeked)
+        std::uint32_t turn;  // Global turn index when it happened
+    };
+
+    // Receives the events of a game; install one with Game::set_event_sink()
+    class EventSink
+    {
+    public:
+        virtual ~EventSink() = default;
+        virtual void on_event(const GameEvent &event) = 0; // Called once per event
+        virtual void flush() {}                            // Push buffered output
+    };
+
+    // Discards everything
+    class NullSink : public EventSink
+    {
+    public:
+        void on_event(const GameEvent &) override {}
+    };
+
+    // Writes the classic human-readable log lines through a fixed buffer (no per-event allocation)
+    class TextSink : public EventSink
+    {
+    private:
+        const Game &game;         // Used to resolve player names
+        std::ostream &out;        // Destination
+        std::vector<char> buffer; // Pending text
+        std::size_t used;         // Bytes of buffer in use
+
+        void append(const char *text, std::size_t length); // Add text, writing out when full
+        void append(const char *text);                     // Add a C string
+        void append_name(PlayerId player);                 // Add a player's name
+
+    public:
+        TextSink(const Game &game, std::ostream &out, std::size_t capacity = 1 << 14); // capacity 0 writes through
+        ~TextSink() override; // Flushes pending text
+
+        void on_event(const GameEvent &event) override;
+        void flush() override;
+    };
+
+    // Appends fixed-size binary records to a stream through a fixed buffer
+    class BinarySink : public EventSink
+    {
+    private:
+        std::ostream &out;                 // Destination
+        std::vector<std::uint8_t> buffer;  // Pending records
+        std::size_t used;                  // Bytes of buffer in use
+
+    public:
+        static constexpr std::size_t kRecordSize = 12; // Bytes per encoded event
+
+        explicit BinarySink(std::ostream &out, std::size_t capacity = 1 << 16); // Constructor
+        ~BinarySink() override; // Flushes pending records
+
+        void on_event(const GameEvent &event) override;
+        void flush() override;
+
+        static void encode(const GameEvent &event, std::uint8_t *record);       // Write one record (little-endian)
+        static GameEvent decode(const std::uint8_t *record);                    // Read one record
+    };
+
+}
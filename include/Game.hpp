@@ -3,8 +3,14 @@
 
 #include <vector>
 #include <string>
-#include <map>
+#include <tuple>
+#include <unordered_map>
 #include <memory>
+#include "GameState.hpp"
+#include "EventSink.hpp"
+#include "ActionHistory.hpp"
+#include "Zobrist.hpp"
+#include "MoveJournal.hpp"
 
 namespace coup
 {
@@ -13,53 +19,149 @@ namespace coup
 
     class Game
     {
+        friend class Player; // Players report eliminations and revivals
+
     private:
         std::vector<std::shared_ptr<Player>> players_list; // List of all players
-        size_t turn_index; // Index of current turn
-        size_t global_turn_index; // Total turn counter
-
-        int current_round; // Current round number
-
-        std::map<std::string, int> tax_turns; // Tracks tax turns per player
-
-        std::vector<std::pair<std::string, std::string>> coup_list; // List of coup actions (attacker, target)
-        std::string last_arrested_name; // Last arrested player's name
-        std::string last_tax_player_name; // Last player who performed tax
-        std::vector<std::tuple<std::string, std::string, int>> action_history; // Log of actions (player, action, round)
+        GameState state; // Turn counters, coup/tax records and the state of every player
+        std::unordered_map<std::string, PlayerId> player_ids; // Player name -> PlayerId (API boundary only)
+        std::size_t max_players; // Table size: seats add_player may fill (at most kMaxPlayers)
+
+        ActionHistory history; // Most recent actions, fixed capacity
+        EventSink *sink = nullptr; // Receives action events (not owned; none by default)
+        MoveJournal journal; // Undo log for make/unmake search (off by default)
+
+        template <typename T>
+        void touch(const T &field) // Journal a field of state before it is written
+        {
+            static_assert(sizeof(T) <= sizeof(JournalEntry::bytes), "Journaled fields must fit an entry");
+            if (journal.enabled())
+                journal.save(state, &field, sizeof(T));
+        }
+
+        void set_alive(PlayerId player, bool alive); // Keep the alive mask up to date and report winner changes
+        void rehash(HashFeature feature, PlayerId player, int before, int after) // Swap one feature's key in the position hash
+        {
+            if (before != after && player != kNoPlayer)
+                state.hash ^= zobrist_key(feature, player, before) ^ zobrist_key(feature, player, after);
+        }
+        void refresh_tax_window(); // Recompute whether the latest tax can still be undone
 
     public:
-        Game(); // Constructor
+        explicit Game(std::size_t max_players = kDefaultMaxPlayers); // Constructor (table size, 1..kMaxPlayers)
 
         virtual ~Game(); // Destructor
 
         const std::vector<std::shared_ptr<Player>>& get_all_players() const; // Get all players
         
         std::shared_ptr<Player>& get_player(const std::string &name); // Get player by name
+        PlayerId find_player_id(const std::string &name) const; // Get player index by name (kNoPlayer if missing)
         std::shared_ptr<Player>& get_current_player(); // Get current turn player
-        int get_active_players_count() const; // Count active (non-eliminated) players
-        int get_current_round() const { return current_round; } // Get current round number
-
-        size_t get_turn_index() const { return turn_index; } // Get turn index
-        size_t get_global_turn_index() const { return global_turn_index; } // Get global turn index
-
-        std::vector<std::tuple<std::string, std::string, int>> &get_action_history() { return action_history; } // Get action history
-        std::vector<std::pair<std::string, std::string>> &get_coup_list() { return coup_list; } // Get list of coup actions
-        bool is_in_coup_list(const std::string &target_name) const; // Check if a player is in coup_list
-        std::map<std::string, int> &get_tax_turns(); // Get tax turn map
+        int get_active_players_count() const { return mask_count(state.alive); } // Count active (non-eliminated) players
+        PlayerMask get_alive_mask() const { return state.alive; } // Active players, one bit per PlayerId
+        int get_current_round() const { return state.current_round; } // Get current round number
+        std::size_t get_max_players() const { return max_players; } // Table size
+        void set_max_players(std::size_t seats); // Resize the table (never below the seated players)
+
+        size_t get_turn_index() const { return state.turn_index; } // Get turn index
+        size_t get_global_turn_index() const { return state.global_turn_index; } // Get global turn index
+
+        const GameState &get_state() const { return state; } // Get a view of the game state (copy it to clone)
+        void set_state(const GameState &saved); // Restore a previously copied state
+        std::vector<std::uint8_t> snapshot() const; // Save players and state as a compact versioned blob
+        void snapshot(std::vector<std::uint8_t> &out) const; // Same, into a reused buffer
+        void restore(const std::uint8_t *data, std::size_t size); // Load a blob (seats its players if the game is empty)
+        void restore(const std::vector<std::uint8_t> &blob) { restore(blob.data(), blob.size()); } // Load a blob
+        std::uint64_t get_hash() const { return state.hash; } // Zobrist hash of the current position, kept up to date by every action
+
+        void enable_journal(std::size_t capacity = MoveJournal::kDefaultCapacity) { journal.enable(capacity); } // Log state writes so moves can be unmade
+        void disable_journal() { journal.disable(); } // Stop logging state writes
+        const MoveJournal &get_journal() const { return journal; } // The undo log
+        JournalMark mark() const // Point to unmake back to (journal must be enabled)
+        {
+            JournalMark at = journal.mark(state);
+            at.actions = history.total_pushed();
+            return at;
+        }
+        void unmake(const JournalMark &to) // Roll the state and the action history back to a mark, in place
+        {
+            journal.undo(state, to);
+            history.rewind(to.actions);
+        }
+
+        const ActionHistory &get_history() const { return history; } // Typed log of the most recent actions
+        void set_history_spill(ActionHistory::SpillHook hook) { history.set_spill_hook(std::move(hook)); } // Receive entries as they fall out of the log
+        std::vector<std::tuple<std::string, std::string, int>> get_action_history() const; // The kept log as (player, action, round)
+        void clear_history() { history.clear(); } // Forget the kept log (when a table is reused for a new game)
+        bool is_in_coup_list(const std::string &target_name) const; // Check if a player has an undoable coup against them
+        bool is_in_coup_list(PlayerId target) const { return state.players[target].couped_by != kNoPlayer; } // Same, by id
+        PlayerId get_coup_attacker(PlayerId target) const { return state.players[target].couped_by; } // Who couped target (kNoPlayer if none)
+        void remove_from_coup_list(PlayerId target) { add_to_coup(kNoPlayer, target); } // Drop the coup record of target
+
+        int get_tax_turn(PlayerId player) const { return state.players[player].last_tax.turn; } // Global turn of player's last tax
+        void set_tax_turn(PlayerId player, int turn) { touch(state.players[player].last_tax); state.players[player].last_tax.turn = turn; refresh_tax_window(); } // Record player's last tax turn
+        const TaxRecord &get_last_tax(PlayerId player) const { return state.players[player].last_tax; } // Player's most recent tax
+        PlayerId get_latest_tax() const { return state.latest_tax; } // Player whose tax an undo would cancel (kNoPlayer if none)
+        void record_tax(PlayerId player, int amount); // Remember a tax so it can be undone
+        void cancel_latest_tax(); // Mark the latest tax undone and expose the one before it
 
         const std::string &get_last_arrested_name() const; // Get last arrested name
         void set_last_arrested_name(const std::string &name); // Set last arrested name
+        PlayerId get_last_arrested() const { return state.last_arrested; } // Get last arrested player
+        void set_last_arrested(PlayerId player) // Set last arrested player
+        {
+            rehash(HashFeature::LastArrested, 0, state.last_arrested, player);
+            touch(state.last_arrested);
+            state.last_arrested = player;
+        }
 
         void add_player(const std::shared_ptr<Player> &player); // Add a new player to the game
         void remove_player(const std::string &target); // Eliminate a player from the game
+        void remove_player(PlayerId target); // Eliminate a player from the game, by id
 
-        std::string turn() const; // Get the name of the player whose turn it is
+        const std::string &turn() const; // Get the name of the player whose turn it is (no copy)
 
         void add_to_coup(const std::string &attacker, const std::string &target); // Add a coup record
+        void add_to_coup(PlayerId attacker, PlayerId target) // Add a coup record, by id
+        {
+            PlayerId before = state.players[target].couped_by;
+            if (before == attacker)
+                return;
+            rehash(HashFeature::CoupedBy, target, before, attacker);
+            touch(state.players[target].couped_by);
+            state.players[target].couped_by = attacker;
+            if (before != kNoPlayer) // Keep the per-attacker reverse index in step
+            {
+                touch(state.players[before].coups_by);
+                state.players[before].coups_by &= ~player_bit(target);
+            }
+            if (attacker != kNoPlayer)
+            {
+                touch(state.players[attacker].coups_by);
+                state.players[attacker].coups_by |= player_bit(target);
+            }
+        }
 
         std::string winner() const; // Get the winner of the game
+        bool is_game_over() const { return state.alive != 0 && (state.alive & (state.alive - 1)) == 0; } // Is exactly one player left (never throws)
+        PlayerId get_winner() const { return is_game_over() ? mask_first(state.alive) : kNoPlayer; } // The winner, or kNoPlayer while undecided
+
+        ActionSet legal_actions() const; // Legal moves of the current player
+        ActionSet legal_actions(PlayerId actor) const; // Legal moves of a player, including out-of-turn abilities
+
+        void set_event_sink(EventSink *new_sink) { sink = new_sink; } // Install an event sink (nullptr disables events)
+        EventSink *get_event_sink() const { return sink; } // Get the installed event sink
+        void emit(EventType type, PlayerId actor, PlayerId target = kNoPlayer, int amount = 0) // Log actions and report the event to the sink
+        {
+            if (type < EventType::ArrestUnblocked)
+                history.push(HistoryEntry{static_cast<ActionKind>(type), actor, target,
+                                          static_cast<std::int16_t>(amount), state.current_round, state.global_turn_index});
+            if (sink)
+                sink->on_event(GameEvent{type, actor, target, amount, state.global_turn_index});
+        }
 
         void next_turn(); // Advance to the next turn
+        void pass_turn(); // Skip the current player's turn (no legal move), reporting it to the sink
     };
 
 }
@@ -0,0 +1,136 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "Role.hpp"
+
+namespace coup
+{
+
+    using PlayerId = std::uint8_t;         // Dense player index (order of joining the game)
+    constexpr PlayerId kNoPlayer = 0xFF;   // Marks "no player"
+    constexpr std::size_t kMaxPlayers = 64;       // Largest table the state can hold
+    constexpr std::size_t kDefaultMaxPlayers = 6; // Seats of a standard table (Game's default limit)
+
+    using PlayerMask = std::uint64_t; // One bit per PlayerId
+    static_assert(kMaxPlayers <= 64, "a PlayerMask must have a bit for every player");
+
+    // Bit of a single player
+    inline PlayerMask player_bit(PlayerId player) { return PlayerMask(1) << player; }
+
+    // Number of players in a mask
+    inline int mask_count(PlayerMask mask)
+    {
+#if defined(__GNUC__)
+        return __builtin_popcountll(mask);
+#else
+        int count = 0;
+        for (; mask; mask &= mask - 1)
+            count++;
+        return count;
+#endif
+    }
+
+    // Lowest player in a mask (kNoPlayer if empty)
+    inline PlayerId mask_first(PlayerMask mask)
+    {
+        if (mask == 0)
+            return kNoPlayer;
+#if defined(__GNUC__)
+        return static_cast<PlayerId>(__builtin_ctzll(mask));
+#else
+        PlayerId player = 0;
+        while (!(mask & 1))
+        {
+            mask >>= 1;
+            player++;
+        }
+        return player;
+#endif
+    }
+
+    // First player in a mask after the given one, wrapping around (kNoPlayer if empty)
+    inline PlayerId mask_next(PlayerMask mask, PlayerId after)
+    {
+        PlayerMask later = after >= 63 ? 0 : mask & (~PlayerMask(0) << (after + 1));
+        return mask_first(later ? later : mask);
+    }
+
+    // Boolean player flags packed into PlayerState::flags
+    enum class PlayerFlag : std::uint8_t
+    {
+        Eliminated = 1 << 0,      // Player is out of the game
+        Sanctioned = 1 << 1,      // Player cannot gather or tax
+        DisableToArrest = 1 << 2, // Player cannot use arrest
+        MustCoup = 1 << 3,        // Player started the turn with 10+ coins
+        UsedBribe = 1 << 4,       // Player bribed during their last turn
+        AbilityUsed = 1 << 5      // Role ability (undo / peek) was used this round
+    };
+
+    // A player's most recent tax, as seen by Governor::undo_tax
+    struct TaxRecord
+    {
+        std::uint32_t turn = 0;         // Global turn of the tax
+        std::int8_t amount = 0;         // Coins it gave
+        bool undoable = false;          // Not undone yet
+        PlayerId previous = kNoPlayer;  // Player who taxed just before (undo order)
+    };
+
+    // Everything the rules know about one player (one seat), as plain data
+    struct PlayerState
+    {
+        std::int16_t coins = 0;                // Number of coins
+        RoleId role = RoleId::Governor;        // Player's role
+        std::int8_t extra_turns = 0;           // Extra turns left from a bribe
+        std::int8_t disable_arrest_turns = 0;  // Turns left before arrest is allowed again
+        std::uint8_t flags = 0;                // PlayerFlag bits
+        PlayerId sanctioned_by = kNoPlayer;    // Player who applied the current sanction
+        PlayerId couped_by = kNoPlayer;        // Attacker of a still-undoable coup on this player
+        TaxRecord last_tax;                    // This player's most recent tax
+        PlayerMask sanctions_by = 0;           // Players this player currently keeps sanctioned
+        PlayerMask coups_by = 0;               // Targets of this player's still-undoable coups (reverse of couped_by)
+
+        bool has(PlayerFlag flag) const { return (flags & static_cast<std::uint8_t>(flag)) != 0; } // Test a flag
+        void set(PlayerFlag flag, bool on)                                                         // Set or clear a flag
+        {
+            if (on)
+                flags |= static_cast<std::uint8_t>(flag);
+            else
+                flags &= static_cast<std::uint8_t>(~static_cast<std::uint8_t>(flag));
+        }
+    };
+
+    // Complete mutable state of a game; a plain value that can be copied with memcpy.
+    // The seats come last, so copy_state copies only the used ones.
+    struct GameState
+    {
+        std::uint32_t global_turn_index = 0; // Total turn counter
+        std::uint32_t current_round = 1;     // Current round number
+        std::uint8_t player_count = 0;       // Number of used player slots
+        std::uint8_t turn_index = 0;         // Player whose turn it is
+        PlayerId last_arrested = kNoPlayer;  // Last arrested player
+        PlayerId latest_tax = kNoPlayer;     // Player whose tax an undo would cancel
+        bool tax_window = false;             // Latest tax is still young enough to undo
+        PlayerMask alive = 0;                // Players not eliminated, one bit per PlayerId
+        PlayerMask abilities_used = 0;       // Players whose AbilityUsed flag is set (cleared each round)
+        std::uint64_t hash = 0;              // Zobrist hash of the position (see Zobrist.hpp)
+        PlayerState players[kMaxPlayers];    // Per-player state, indexed by PlayerId (first player_count used)
+    };
+
+    // Copies from into to, up to from's last used seat: one memcpy whose size follows
+    // the table, not kMaxPlayers. Seats that only to used are emptied, so the
+    // result equals a full copy.
+    inline void copy_state(GameState &to, const GameState &from)
+    {
+        for (std::size_t i = from.player_count; i < to.player_count; ++i)
+            to.players[i] = PlayerState();
+        std::memcpy(static_cast<void *>(&to), &from, offsetof(GameState, players) + from.player_count * sizeof(PlayerState));
+    }
+
+    static_assert(std::is_trivially_copyable<PlayerState>::value, "PlayerState must stay trivially copyable");
+    static_assert(std::is_trivially_copyable<GameState>::value, "GameState must stay trivially copyable");
+    static_assert(std::is_standard_layout<GameState>::value, "copy_state needs offsetof(GameState, players)");
+}
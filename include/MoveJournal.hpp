@@ -0,0 +1,63 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "GameState.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace coup
+{
+
+    // Old value of one GameState field, saved just before it was overwritten
+    struct JournalEntry
+    {
+        std::uint16_t offset; // Byte offset of the field in GameState
+        std::uint8_t size;    // Field size in bytes (at most 8)
+        std::uint64_t bytes;  // Previous contents of the field
+    };
+
+    // Point a journal can be rolled back to
+    struct JournalMark
+    {
+        std::size_t entries = 0;   // Journal length when the mark was taken
+        std::uint64_t hash = 0;    // Position hash at the mark (hash updates are not journaled)
+        std::uint64_t actions = 0; // Actions logged at the mark (ActionHistory::total_pushed)
+    };
+
+    // Undo log of GameState writes, so search can make and unmake moves in place.
+    // Storage is reserved up front and reused: once warmed up, neither logging nor
+    // rolling back allocates.
+    class MoveJournal
+    {
+    public:
+        static constexpr std::size_t kDefaultCapacity = 4096; // Entries reserved by enable()
+
+    private:
+        std::vector<JournalEntry> entries; // Saved fields, oldest first
+        bool active = false;               // Writes are logged
+
+    public:
+        void enable(std::size_t capacity = kDefaultCapacity); // Start logging (drops any previous entries)
+        void disable();                                       // Stop logging and drop the entries
+        bool enabled() const { return active; }               // Are writes logged
+        void clear() { entries.clear(); }                     // Drop the entries, keep logging
+
+        void save(const GameState &state, const void *field, std::size_t size) // Log a field of state before it changes
+        {
+            std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(field) - reinterpret_cast<std::uintptr_t>(&state);
+            if (offset >= sizeof(GameState))
+                return; // Not part of the shared state (a player that has not joined yet)
+            JournalEntry entry{static_cast<std::uint16_t>(offset), static_cast<std::uint8_t>(size), 0};
+            std::memcpy(&entry.bytes, field, size);
+            entries.push_back(entry);
+        }
+        JournalMark mark(const GameState &state) const { return JournalMark{entries.size(), state.hash}; } // Current rollback point
+        void undo(GameState &state, const JournalMark &to); // Restore every field written since `to`, newest first
+
+        std::size_t size() const { return entries.size(); }         // Entries logged
+        std::size_t capacity() const { return entries.capacity(); } // Entries that fit without allocating
+    };
+
+}
@@ -5,6 +5,8 @@
 #include <set>
 #include <map>
 #include "Game.hpp"
+#include "GameState.hpp"
+#include "Action.hpp"
 #include <memory>
 
 namespace coup
@@ -14,26 +16,51 @@ namespace coup
 
     class Player
     {
+        friend class Game; // Game attaches the player to its state slot
+
     private:
-        bool eliminated; // Is the player eliminated from the game
-        bool disable_to_arrest; // Is the player protected from arrest
+        PlayerId id;        // Index in the game (kNoPlayer until added)
+        PlayerState local;  // State storage used until the player joins a game
+
+        void attach(PlayerId slot_id, PlayerState *slot); // Move state into the game's slot
 
     protected:
         Game &game; // Reference to the game instance
         std::string name; // Player name
-        int coins; // Number of coins the player has
-        bool mustPerformCoup; // Flag indicating whether the player must perform a coup
-        bool sanctioned; // Is the player sanctioned
-        int extra_turns; // Number of extra turns
-        std::string sanctioned_by; // Name of the player who sanctioned this player
-        int disable_arrest_turns; // Number of turns arrest is disabled
-        bool used_bribe; // Flag for whether the player used bribe last turn
-       
+        PlayerState *state; // Player's state (inside the game's GameState once added)
+
+        Player *player_at(PlayerId player) const; // Player with that id in this game (nullptr if none)
+        void set_coins(int coins) // Change the coin count, keeping the position hash current
+        {
+            game.rehash(HashFeature::Coins, id, state->coins, coins);
+            game.touch(state->coins);
+            state->coins = static_cast<std::int16_t>(coins);
+        }
+        void set_flag(PlayerFlag flag, bool on) // Change a flag, keeping the position hash current
+        {
+            std::uint8_t before = state->flags;
+            game.touch(state->flags);
+            state->set(flag, on);
+            game.rehash(HashFeature::Flags, id, before, state->flags);
+            if (flag == PlayerFlag::AbilityUsed && id != kNoPlayer) // Index for the round reset in next_turn
+            {
+                game.touch(game.state.abilities_used);
+                if (on)
+                    game.state.abilities_used |= player_bit(id);
+                else
+                    game.state.abilities_used &= ~player_bit(id);
+            }
+        }
+        [[noreturn]] void raise(ActionStatus status, ActionKind kind, const Player *target = nullptr) const; // Throw the exception matching a failed action
 
     public:
-        Player(Game &game, const std::string &name); // Constructor
+        Player(Game &game, const std::string &name, RoleId role); // Constructor
+        Player(const Player &) = delete;             // Players are identities, not values
+        Player &operator=(const Player &) = delete;
         virtual ~Player(); // Destructor
         virtual std::string role() const = 0; // Get role name (pure virtual)
+        RoleId role_id() const { return state->role; } // Get role (no allocation)
+        const RoleTraits &traits() const { return role_traits(state->role); } // Get role rule parameters
 
         virtual void gather(); // Gain 1 coin
         virtual void tax();  // Gain 2 coins
@@ -42,51 +69,95 @@ namespace coup
         virtual void sanction(const std::shared_ptr<Player> &target); // Sanction another player
         virtual void coup(const std::shared_ptr<Player> &target); // Eliminate another player
 
+        ActionStatus try_gather(); // Gather without throwing
+        ActionStatus try_tax(); // Tax without throwing
+        ActionStatus try_bribe(); // Bribe without throwing
+        ActionStatus try_arrest(PlayerId target); // Arrest without throwing
+        ActionStatus try_sanction(PlayerId target); // Sanction without throwing
+        ActionStatus try_coup(PlayerId target); // Coup without throwing
+
+        ActionStatus check_gather() const; // Would gather be accepted now
+        ActionStatus check_tax() const; // Would tax be accepted now
+        ActionStatus check_bribe() const; // Would bribe be accepted now
+        ActionStatus check_arrest(PlayerId target) const; // Would arresting target be accepted now
+        ActionStatus check_sanction(PlayerId target) const; // Would sanctioning target be accepted now
+        ActionStatus check_coup(PlayerId target) const; // Would a coup on target be accepted now
+
         const std::string &get_name() const { return name; } // Get player name
+        PlayerId get_id() const { return id; } // Get player index in the game
+        ActionStatus turn_status() const; // Ok if it's this player's turn
         void check_turn() const; // Check if it's this player's turn
         void revive(); // Revive player (used by General)
-        int get_coins() const { return coins; } // Get coin count
+        int get_coins() const { return state->coins; } // Get coin count
         void decrease_coins(int amount); // Reduce coin count
         void increase_coins(int amount); // Increase coin count
 
-        void mark_eliminated() { eliminated = true; } // Mark player as eliminated
-        bool is_eliminated() const { return eliminated; } // Is player eliminated
+        void mark_eliminated(); // Mark player as eliminated
+        bool is_eliminated() const { return state->has(PlayerFlag::Eliminated); } // Is player eliminated
 
         void mark_sanctioned(const std::string &by_whom); // Sanction the player
+        void mark_sanctioned(PlayerId by_whom); // Sanction the player, by id
         void clear_sanctioned(); // Remove sanction
-        bool is_sanctioned() const { return sanctioned; } // Is player currently sanctioned
+        bool is_sanctioned() const { return state->has(PlayerFlag::Sanctioned); } // Is player currently sanctioned
+        PlayerId get_sanctioned_by() const { return state->sanctioned_by; } // Who applied the current sanction
 
-        void set_disable_to_arrest(bool value) { disable_to_arrest = value; } // Set arrest protection
-        bool is_disable_to_arrest() const { return disable_to_arrest; } // Is arrest protection active
-        void set_disable_arrest_turns(int n) { disable_arrest_turns = n; } // Set turns for arrest protection
-        int get_disable_arrest_turns() const { return disable_arrest_turns; } // Get remaining turns of arrest protection
+        void set_disable_to_arrest(bool value) { set_flag(PlayerFlag::DisableToArrest, value); } // Set arrest protection
+        bool is_disable_to_arrest() const { return state->has(PlayerFlag::DisableToArrest); } // Is arrest protection active
+        void set_disable_arrest_turns(int n) // Set turns for arrest protection
+        {
+            game.rehash(HashFeature::ArrestTurns, id, state->disable_arrest_turns, static_cast<std::int8_t>(n));
+            game.touch(state->disable_arrest_turns);
+            state->disable_arrest_turns = static_cast<std::int8_t>(n);
+        }
+        int get_disable_arrest_turns() const { return state->disable_arrest_turns; } // Get remaining turns of arrest protection
 
-        void set_must_coup(bool value) { mustPerformCoup = value; } // Force player to coup
-        bool must_coup() const { return mustPerformCoup; } // Check if player must coup
+        void set_must_coup(bool value) { set_flag(PlayerFlag::MustCoup, value); } // Force player to coup
+        bool must_coup() const { return state->has(PlayerFlag::MustCoup); } // Check if player must coup
 
-        bool is_used_bribe() const { return used_bribe; } // Did player use bribe
-        void mark_used_bribe() { used_bribe = true; } // Mark bribe used
-        void reset_used_bribe() { used_bribe = false; } // Reset bribe usage
+        bool is_used_bribe() const { return state->has(PlayerFlag::UsedBribe); } // Did player use bribe
+        void mark_used_bribe() { set_flag(PlayerFlag::UsedBribe, true); } // Mark bribe used
+        void reset_used_bribe() { set_flag(PlayerFlag::UsedBribe, false); } // Reset bribe usage
 
-        bool is_extra_turn() const { return extra_turns > 0; } // Does player have extra turns
-        void set_extra_turns(int value) { extra_turns = value; } // Set number of extra turns
-        int get_extra_turns() const { return extra_turns; } // Get number of extra turns
+        bool is_extra_turn() const { return state->extra_turns > 0; } // Does player have extra turns
+        void set_extra_turns(int value) // Set number of extra turns
+        {
+            game.rehash(HashFeature::ExtraTurns, id, state->extra_turns, static_cast<std::int8_t>(value));
+            game.touch(state->extra_turns);
+            state->extra_turns = static_cast<std::int8_t>(value);
+        }
+        int get_extra_turns() const { return state->extra_turns; } // Get number of extra turns
 
-        virtual void start_new_turn() // Start of new turn
+        void start_new_turn() // Start of new turn
         {
-            mustPerformCoup = (coins >= 10); // Automatically enforce COUP if player has 10+ coins
+            set_must_coup(state->coins >= kMustCoupCoins); // Automatically enforce COUP if player has 10+ coins
 
-            // Clear sanctions the player applied to others
-            for (const std::shared_ptr<Player> &player : game.get_all_players())
+            // Clear sanctions the player applied to others (eliminated players keep theirs)
+            if (id != kNoPlayer)
             {
-                if (player->is_eliminated())
-                    continue;
-                if (player->is_sanctioned() && player->sanctioned_by == name)
+                GameState &shared = game.state;
+                PlayerMask lifted = shared.players[id].sanctions_by & shared.alive;
+                if (lifted)
+                    game.touch(shared.players[id].sanctions_by);
+                shared.players[id].sanctions_by &= ~lifted;
+                for (; lifted; lifted &= lifted - 1)
                 {
-                    player->clear_sanctioned();
+                    PlayerId victim_id = mask_first(lifted);
+                    PlayerState &victim = shared.players[victim_id];
+                    std::uint8_t before = victim.flags;
+                    game.touch(victim.flags);
+                    game.touch(victim.sanctioned_by);
+                    victim.set(PlayerFlag::Sanctioned, false);
+                    game.rehash(HashFeature::Flags, victim_id, before, victim.flags);
+                    game.rehash(HashFeature::SanctionedBy, victim_id, victim.sanctioned_by, kNoPlayer);
+                    victim.sanctioned_by = kNoPlayer;
                 }
             }
             reset_used_bribe(); // Reset bribe status for new turn
+
+            // Role bonus (Merchant): one extra coin when starting the turn with enough coins
+            int threshold = traits().turn_bonus_threshold;
+            if (threshold > 0 && state->coins >= threshold)
+                set_coins(state->coins + 1);
         }
     };
 
@@ -0,0 +1,50 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace coup
+{
+
+    // Role of a player, stored in the player's state
+    enum class RoleId : std::uint8_t
+    {
+        Governor,
+        Spy,
+        Baron,
+        General,
+        Judge,
+        Merchant,
+        Count
+    };
+
+    constexpr std::size_t kRoleCount = static_cast<std::size_t>(RoleId::Count);
+
+    // Rule parameters that depend on a player's role
+    struct RoleTraits
+    {
+        const char *name;         // Role name, as returned by Player::role()
+        int tax_amount;           // Coins gained by tax
+        int sanction_cost;        // Coins the attacker pays to sanction this role
+        int sanction_refund;      // Coins this role gets back when sanctioned
+        int arrest_min_coins;     // Coins this role must hold to be arrested
+        int arrest_loss;          // Coins this role loses when arrested
+        int arrest_gain;          // Coins the attacker gains when arresting this role
+        int turn_bonus_threshold; // Bonus coin at turn start when holding at least this many (0 = none)
+        bool round_ability;       // Has a once-per-round ability that resets every round
+    };
+
+    constexpr RoleTraits kRoleTraits[kRoleCount] = {
+        // name        tax sanc refund minArr loss gain bonus ability
+        {"Governor",   3,  3,   0,     1,     1,   1,   0,    true},
+        {"Spy",        2,  3,   0,     1,     1,   1,   0,    true},
+        {"Baron",      2,  3,   1,     1,     1,   1,   0,    false},
+        {"General",    2,  3,   0,     1,     0,   1,   0,    true},
+        {"Judge",      2,  4,   0,     1,     1,   1,   0,    true},
+        {"Merchant",   2,  3,   0,     2,     2,   0,   3,    false},
+    };
+
+    // Rule parameters of a role
+    constexpr const RoleTraits &role_traits(RoleId role) { return kRoleTraits[static_cast<std::size_t>(role)]; }
+}
@@ -0,0 +1,38 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace coup
+{
+
+    // Append an unsigned LEB128 varint (7 bits per byte, low bits first)
+    inline void write_varint(std::vector<std::uint8_t> &out, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // Read an unsigned LEB128 varint; false if the data ends early or the varint is too long
+    inline bool read_varint(const std::uint8_t *&at, const std::uint8_t *end, std::uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && at != end; shift += 7)
+        {
+            std::uint8_t byte = *at++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    inline std::uint64_t zigzag(std::int64_t value) { return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63); } // Signed to unsigned, small magnitudes stay small
+    inline std::int64_t unzigzag(std::uint64_t value) { return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1); } // Inverse of zigzag
+
+}
@@ -0,0 +1,50 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <cstdint>
+#include "GameState.hpp"
+
+namespace coup
+{
+
+    // Parts of the game state that contribute to the position hash
+    enum class HashFeature : std::uint8_t
+    {
+        Role,         // Player's role
+        Coins,        // Coin count
+        Flags,        // PlayerFlag bits (eliminated, sanctioned, arrest-blocked, ability used, ...)
+        ExtraTurns,   // Extra turns left from a bribe
+        ArrestTurns,  // Turns left before arrest is allowed again
+        SanctionedBy, // Who applied the current sanction
+        CoupedBy,     // Attacker of a still-undoable coup on this player
+        Tax,          // Undo state of the player's last tax (undoable, amount, previous)
+        TurnIndex,    // Whose turn it is
+        LastArrested, // Last arrested player
+        LatestTax,    // Tax an undo would cancel
+        TaxWindow     // That tax is still young enough to undo
+    };
+
+    // Random key of one (feature, player, value) triple; derived with splitmix64 so values are not bounded by a table
+    inline std::uint64_t zobrist_key(HashFeature feature, unsigned player, std::int32_t value)
+    {
+        std::uint64_t x = (static_cast<std::uint64_t>(feature) << 56) ^ (static_cast<std::uint64_t>(player & 0xFF) << 40) ^
+                          static_cast<std::uint32_t>(value);
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    // Hashed value of a tax record (the absolute turn is left out so equal positions hash equally)
+    inline std::int32_t tax_hash_value(const TaxRecord &tax)
+    {
+        return tax.undoable ? (tax.amount << 8) | tax.previous : 0;
+    }
+
+    // Is the latest tax still young enough for a Governor to undo it
+    bool tax_window_open(const GameState &state);
+
+    std::uint64_t hash_player(const GameState &state, PlayerId player); // Hash contribution of one player
+    std::uint64_t hash_state(const GameState &state);                   // Full hash of a state, from scratch (O(players))
+
+}
@@ -1,6 +1,8 @@
 // Author: noapatito123@gmail.com
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -20,7 +22,6 @@ namespace coup
         extern const char *NotYourTurn;
         extern const std::string Sanctioned;
         extern const std::string AlreadySanctioned;
-        extern const std::string MaxPlayersExceeded;
         extern const std::string DuplicateArrest;
         extern const std::string MustPerformCoup;
         extern const std::string TargetNoCoins;
@@ -34,6 +35,9 @@ namespace coup
         extern const std::string InvalidBribeUndo;
         extern const std::string CannotTargetYourself;
         extern const std::string ArrestBlocked;
+        extern const std::string StateMismatch;
+        extern const std::string ReplayFormat;
+        extern const std::string SnapshotFormat;
 
 
         // Dynamic messages
@@ -46,6 +50,9 @@ namespace coup
         std::string CannotUndoOwnAction(const std::string &name, const std::string &action);
         std::string NoRecentActionToUndo(const std::string &action);
         std::string NoCoupToUndo(const std::string &target);
+        std::string ReplayMismatch(std::uint64_t record, const std::string &what);
+        std::string MaxPlayersExceeded(std::size_t limit);
+        std::string InvalidTableSize(std::size_t requested, std::size_t seated, std::size_t capacity);
     }
 
     // === Specific Exceptions ===
@@ -78,7 +85,15 @@ namespace coup
     class MaxPlayersExceededException : public GameException
     {
     public:
-        MaxPlayersExceededException() : GameException(GameExceptionStrings::MaxPlayersExceeded) {}
+        explicit MaxPlayersExceededException(std::size_t limit = 6)
+            : GameException(GameExceptionStrings::MaxPlayersExceeded(limit)) {}
+    };
+
+    class InvalidTableSizeException : public GameException
+    {
+    public:
+        InvalidTableSizeException(std::size_t requested, std::size_t seated, std::size_t capacity)
+            : GameException(GameExceptionStrings::InvalidTableSize(requested, seated, capacity)) {}
     };
 
     class DuplicateArrestException : public GameException
@@ -215,5 +230,29 @@ namespace coup
         ArrestBlockedException() : GameException(GameExceptionStrings::ArrestBlocked) {}
     };
 
-}
+    class StateMismatchException : public GameException
+    {
+    public:
+        StateMismatchException() : GameException(GameExceptionStrings::StateMismatch) {}
+    };
 
+    class ReplayFormatException : public GameException
+    {
+    public:
+        ReplayFormatException() : GameException(GameExceptionStrings::ReplayFormat) {}
+    };
+
+    class SnapshotFormatException : public GameException
+    {
+    public:
+        SnapshotFormatException() : GameException(GameExceptionStrings::SnapshotFormat) {}
+    };
+
+    class ReplayMismatchException : public GameException
+    {
+    public:
+        ReplayMismatchException(std::uint64_t record, const std::string &what)
+            : GameException(GameExceptionStrings::ReplayMismatch(record, what)) {}
+    };
+
+}
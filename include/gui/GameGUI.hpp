@@ -8,7 +8,10 @@
 #include "Button.hpp"
 #include "TextBox.hpp"
 #include "Game.hpp"
+#include "Mcts.hpp"
+#include <future>
 #include <memory>
+#include <iostream>
 
 namespace coup
 {
@@ -23,6 +26,8 @@ namespace coup
     class GameGUI
     {
     public:
+        static constexpr std::size_t kMaxSeats = 10; // Most seats the window lays out (larger tables run in Sim)
+
         GameGUI();             // Constructor
         void run();            // Start the GUI loop
         void setupButtons();   // Create and arrange buttons
@@ -30,6 +35,7 @@ namespace coup
         // Add special action buttons for a given role
         int addRoleActionButtons(const std::string &role,
                                  const std::string &buttonPrefix,
+                                 ActionKind ability,
                                  float startY,
                                  std::function<void(const std::shared_ptr<Player> &)> actionPerPlayer);
         std::string inGameError; // Stores in-game error message
@@ -41,25 +47,38 @@ namespace coup
         std::vector<Button> targetButtons;                                 // Buttons for choosing a target
         std::function<void(const std::shared_ptr<Player> &)> targetAction; // Action to execute on selected target
 
-        TextBox *nameBox;     // Input for player name
-        Button *addPlayerBtn; // Button to add a player
-        Button *startGameBtn; // Button to start the game
-        Button *demoGameBtn;  // Button to start a demo game
+        TextBox *nameBox;      // Input for player name
+        Button *addPlayerBtn;  // Button to add a player
+        Button *startGameBtn;  // Button to start the game
+        Button *demoGameBtn;   // Button to start a demo game
+        Button *addBotBtn;     // Button to add a computer player
+        Button *fewerSeatsBtn; // Button to shrink the table
+        Button *moreSeatsBtn;  // Button to grow the table
 
         std::vector<std::string> tempNames; // Temp storage for player names
         std::vector<std::string> tempRoles; // Temp storage for player roles
+        std::vector<bool> tempBots;         // Temp storage: is the player a bot
+        std::vector<bool> botSeats;         // Bot flag per PlayerId of the running game
         std::string setupError;             // Setup error message
         std::string actionMessage;          // Message about the last action
         std::string winnerMessage;          // Message shown when someone wins
         bool showVictory = false;           // Flag to indicate if victory screen should be shown
 
         Game game;                        // Main game object
+        TextSink consoleLog;              // Prints game events to the console
         GUIState state = GUIState::Setup; // Current GUI state
+        MctsStrategy bot;                 // Search used by every bot seat
+        SimRng botRng;                    // Random engine of the bot search
+        std::unique_ptr<Game> botGame;    // Copy of the game the bot searches, off the render thread
+        std::future<Action> botMove;      // Move being searched (valid while a bot thinks)
+        SimRng roleRng;                   // Random engine of role assignment
 
         // Display menu for selecting a target player
         void showTargetSelection(std::function<void(const std::shared_ptr<Player> &)> action, const std::vector<std::shared_ptr<Player>> targets, bool includeCurrentPlayer = false);
 
         std::string randomRole(); // Returns a random role
+        bool addSetupPlayer(const std::string &name, bool isBot); // Validate and queue a player on the setup screen
+        void playBotTurn(); // Start or finish the bot's search if it is a bot's turn (never blocks)
     };
 
 } // namespace coup
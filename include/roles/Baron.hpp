@@ -13,6 +13,8 @@ namespace coup
         ~Baron() override; // Destructor
 
         void invest(); // Special action for Baron
+        ActionStatus try_invest(); // Invest without throwing
+        ActionStatus check_invest() const; // Would invest be accepted now
 
         std::string role() const override; // Returns the role name
     };
@@ -8,17 +8,16 @@ namespace coup
     // Judge is a final role derived from Player
     class Judge final : public Player
     {
-    private:
-        bool used_undo_this_round = false; // Flag to track if undo_bribe was used this round
-
     public:
         Judge(Game &game, const std::string &name); // Constructor
         ~Judge() override; // Destructor
 
-        bool can_undo_bribe() const { return !used_undo_this_round; } // Check if undo_bribe is available
-        void mark_undo_bribe_used() { used_undo_this_round = true; } // Mark undo_bribe as used
-        void reset_undo_bribe_flag() { used_undo_this_round = false; } // Reset the flag for a new round
+        bool can_undo_bribe() const { return !state->has(PlayerFlag::AbilityUsed); } // Check if undo_bribe is available
+        void mark_undo_bribe_used() { set_flag(PlayerFlag::AbilityUsed, true); } // Mark undo_bribe as used
+        void reset_undo_bribe_flag() { set_flag(PlayerFlag::AbilityUsed, false); } // Reset the flag for a new round
         std::string undo_bribe(const std::shared_ptr<Player>& target); // Undo a bribe on a target player
+        ActionStatus try_undo_bribe(PlayerId target); // Undo a bribe without throwing
+        ActionStatus check_undo_bribe(PlayerId target) const; // Would undoing target's bribe be accepted now
         
         std::string role() const override; // Return role name
     };
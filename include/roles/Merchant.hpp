@@ -11,8 +11,6 @@ namespace coup
         Merchant(Game& game, const std::string& name); // Constructor
         ~Merchant() override; // Destructor
 
-        void start_new_turn() override; // Called at the start of each turn
-        
         std::string role() const override; // Return role name
     };
 }
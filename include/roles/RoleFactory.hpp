@@ -0,0 +1,18 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Player.hpp"
+#include <memory>
+#include <string>
+
+namespace coup
+{
+    // Looks up a role by name (throws std::invalid_argument for unknown names)
+    RoleId role_from_name(const std::string &role);
+
+    // Creates a player of the given role name ("Governor", "Spy", "Baron", "General", "Judge", "Merchant")
+    std::shared_ptr<Player> create_player(Game &game, const std::string &role, const std::string &name);
+
+    // Creates a player of the given role
+    std::shared_ptr<Player> create_player(Game &game, RoleId role, const std::string &name);
+}
@@ -8,17 +8,16 @@ namespace coup {
 
     // Spy is a final role derived from Player
     class Spy final : public Player {
-    private:
-        bool used_peek_and_disable = false; // Flag to track if special action was used
-
     public:
         Spy(Game& game, const std::string& name); // Constructor
         ~Spy() override; // Destructor
 
         std::string peek_and_disable(const std::shared_ptr<Player>& target); // Special action: peek and disable
-        bool can_peek_and_disable() const { return !used_peek_and_disable; } // Check if action is available
-        void mark_peek_and_disable_used() { used_peek_and_disable = true; } // Mark action as used
-        void reset_peek_and_disable_flag() { used_peek_and_disable = false; } // Reset flag for new round
+        ActionStatus try_peek_and_disable(PlayerId target); // Peek and disable without throwing
+        ActionStatus check_peek_and_disable(PlayerId target) const; // Would peek and disable be accepted now
+        bool can_peek_and_disable() const { return !state->has(PlayerFlag::AbilityUsed); } // Check if action is available
+        void mark_peek_and_disable_used() { set_flag(PlayerFlag::AbilityUsed, true); } // Mark action as used
+        void reset_peek_and_disable_flag() { set_flag(PlayerFlag::AbilityUsed, false); } // Reset flag for new round
 
         std::string role() const override; // Return role name
     };
@@ -0,0 +1,76 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Game.hpp"
+#include "Strategy.hpp"
+
+namespace coup
+{
+
+    // What one player (the observer) can tell about every player's coins from the
+    // actions in Game::get_history(). Payments are made on the table and are exact:
+    // coups, bribes, sanctions, invest stakes, arrests and undone taxes and coups.
+    // Income from the bank is taken in private: the table sees that a player
+    // taxed, but counts it as the least to the most any role gets (2 to 3), a
+    // sanction refund as 0 to 1, and the start-of-turn bonus (Merchant) is paid
+    // in silence whenever the count may have reached its threshold. Other players'
+    // counts thus widen into ranges that payments and rule checks narrow again.
+    // The observer's own income is exact, and its Spy peeks show the exact count.
+    class CoinTracker
+    {
+    private:
+        struct Bounds
+        {
+            std::int16_t min = 0; // Fewest coins the player may have
+            std::int16_t max = 0; // Most coins the player may have
+        };
+
+        Bounds players[kMaxPlayers];    // Per PlayerId
+        const Game *followed = nullptr; // Game the bounds describe
+        PlayerId observer = kNoPlayer;  // Whose knowledge the bounds are
+        std::uint64_t seen = 0;         // History entries taken in
+        std::uint32_t turn = 0;         // Global turn settled so far
+        PlayerId current = 0;           // Whose turn that is
+        PlayerMask alive = 0;           // Players in the game, as announced
+
+        void gain(PlayerId player, int amount);                        // Announced income
+        void income(PlayerId player, int amount, int least, int most); // Private income: exact for the observer, a range for the others
+        void pay(PlayerId player, int amount);                         // Announced payment (proves the coins were there)
+        void prove(PlayerId player, int at_least);                     // A rule proved the player held at least this many
+        void advance(std::uint32_t to, const GameState &state);        // Start every turn up to global turn `to`, paying turn bonuses
+        void turn_bonus(PlayerId player, RoleId role);                 // The player's turn started
+
+    public:
+        void reset(const Game &game, PlayerId observer);                 // Follow game for observer from here; its current counts are public (as at the deal)
+        void sync(const Game &game, PlayerId observer);                  // Take in the actions logged since the last call (resets if game or observer is new)
+        void observe(const HistoryEntry &entry, const GameState &state); // Take in one logged action
+        void set_bounds(PlayerId player, int min_coins, int max_coins);  // Hand-set what the observer knows (positions set up off the record)
+
+        PlayerId get_observer() const { return observer; }                   // Whose knowledge the bounds are
+        int min_coins(PlayerId player) const { return players[player].min; } // Lower bound
+        int max_coins(PlayerId player) const { return players[player].max; } // Upper bound
+    };
+
+    // What one player legitimately knows about a game: everything except the other
+    // players' coins, which are known only as far as its CoinTracker can tell.
+    class InfoSetView
+    {
+    private:
+        const Game &game;         // The real game (its hidden parts are never exposed)
+        const CoinTracker &tracker; // The observer's coin bounds, synced with game
+        PlayerId observer;          // Whose knowledge this is
+
+    public:
+        InfoSetView(const Game &game, const CoinTracker &tracker) : game(game), tracker(tracker), observer(tracker.get_observer()) {} // Constructor
+
+        PlayerId get_observer() const { return observer; } // Whose knowledge this is
+        bool knows_coins(PlayerId player) const;           // Does the observer know the exact count
+        int min_coins(PlayerId player) const;              // Fewest coins the player may have
+        int max_coins(PlayerId player) const;              // Most coins the player may have
+        int coins(PlayerId player) const;                  // Exact count if known, -1 otherwise
+        ActionSet legal_actions() const;                   // The observer's moves, judged on the counts it knows
+
+        void determinize(GameState &out, SimRng &rng) const; // Fill out with one full state consistent with the observer's knowledge
+    };
+
+}
@@ -0,0 +1,53 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "InfoSet.hpp"
+#include "Mcts.hpp"
+
+namespace coup
+{
+
+    // Single-observer Information Set MCTS: every playout samples a determinization of
+    // the hidden coin counts (InfoSetView) and walks one tree whose nodes are moves,
+    // choosing only among moves legal in that sample. Threads build separate trees
+    // (root parallelism over determinizations) that are merged by move at the end.
+    // The threads and the workers (game copy, node pool and scratch state) are kept
+    // between searches, so a search starts no threads and playouts do not allocate.
+    class IsmctsSearch
+    {
+    private:
+        struct Worker; // Per-thread tree and scratch state (defined in Ismcts.cpp)
+
+        MctsConfig config;                           // Search settings (trees is unused: one tree per thread)
+        std::unique_ptr<WorkStealingPool> pool;      // Search threads, started on the first search and kept
+        std::vector<std::unique_ptr<Worker>> workers; // Kept between searches
+        CoinTracker coins;                           // The observer's coin bounds in the searched game, synced every search
+        MctsStats last;                              // Stats of the latest search
+
+    public:
+        explicit IsmctsSearch(const MctsConfig &config); // Constructor
+        ~IsmctsSearch();                                 // Destructor
+
+        Action search(const Game &game, PlayerId observer, std::uint64_t seed); // Best move for observer, whose turn it is
+        const MctsStats &last_stats() const { return last; } // Stats of the latest search
+        const MctsConfig &get_config() const { return config; } // Search settings
+    };
+
+    // Strategy that picks every move with IsmctsSearch, seeing only what its seat may know
+    class IsmctsStrategy : public Strategy
+    {
+    private:
+        IsmctsSearch searcher; // The search, reused for every move
+        MctsStats total;       // Stats summed over all moves
+
+    public:
+        explicit IsmctsStrategy(const MctsConfig &config = MctsConfig()) : searcher(config) {}
+
+        const char *name() const override { return "ismcts"; }
+        std::shared_ptr<Strategy> clone() const override { return std::make_shared<IsmctsStrategy>(searcher.get_config()); } // Clones start with empty totals
+        Action choose_action(const Game &game, PlayerId self, SimRng &rng) override;
+        const MctsStats &last_stats() const { return searcher.last_stats(); } // Stats of the latest move
+        const MctsStats &total_stats() const { return total; }                // Stats summed over all moves
+    };
+
+}
@@ -0,0 +1,84 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Strategy.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace coup
+{
+
+    // Search settings for MctsSearch
+    struct MctsConfig
+    {
+        std::size_t threads = 1;          // Worker threads
+        std::size_t trees = 1;            // Independent trees (root parallelism); threads are spread over them
+        std::size_t playouts = 2000;      // Playout budget per move (0 = time budget only)
+        double seconds = 0;               // Time budget per move (0 = playout budget only)
+        double exploration = 1.4;         // UCT exploration constant
+        std::uint32_t virtual_loss = 1;   // Visits a thread adds on its way down so others spread out (tree parallelism)
+        std::size_t max_nodes = 1 << 18;  // Node pool per tree; a full pool stops growing the tree
+        std::size_t rollout_limit = 300;  // Plies per playout before it is scored as a draw
+        double greedy_rollouts = 0.5;     // Share of rollout moves taken from GreedyStrategy (the rest are uniform)
+    };
+
+    // What one or more searches did
+    struct MctsStats
+    {
+        std::size_t searches = 0; // Moves searched
+        std::size_t playouts = 0; // Playouts run
+        std::size_t nodes = 0;    // Tree nodes created
+        double seconds = 0;       // Wall time spent searching
+
+        double playouts_per_second() const { return seconds > 0 ? playouts / seconds : 0; } // Search throughput
+    };
+
+    std::unique_ptr<Game> mirror_game(const Game &game); // Private copy of a game (same roles, names and state) for a search thread
+    bool same_table(const Game &copy, const Game &game); // Does copy have game's seats and roles (so set_state is enough to reuse it)
+    void rollout(Game &game, SimRng &rng, const MctsConfig &config, double rewards[kMaxPlayers]); // Finish a game with the playout policy and score it
+
+    // Monte Carlo Tree Search over the current player's legal moves (Game::legal_actions).
+    // Threads share a tree with virtual loss (tree parallelism), or work on separate trees
+    // whose root visit counts are summed at the end (root parallelism), or both.
+    class MctsSearch
+    {
+    private:
+        struct Tree; // Node pool of one tree (defined in Mcts.cpp)
+
+        MctsConfig config;                             // Search settings
+        std::unique_ptr<WorkStealingPool> pool;        // Search threads, started on the first search and kept
+        std::vector<std::unique_ptr<Tree>> trees;       // Node pools, kept between searches
+        std::vector<std::unique_ptr<Game>> mirrors;     // One private game per pool worker, kept between searches
+        std::vector<std::vector<std::uint32_t>> paths; // One playout path buffer per pool worker
+        MctsStats last;                                // Stats of the latest search
+
+    public:
+        explicit MctsSearch(const MctsConfig &config); // Constructor
+        ~MctsSearch();                                 // Destructor
+
+        Action search(const Game &game, std::uint64_t seed); // Best move for the player whose turn it is
+        const MctsStats &last_stats() const { return last; } // Stats of the latest search
+        const MctsConfig &get_config() const { return config; } // Search settings
+    };
+
+    // Strategy that picks every move with MctsSearch and never reacts out of turn
+    class MctsStrategy : public Strategy
+    {
+    private:
+        MctsSearch searcher; // The search, reused for every move
+        MctsStats total;     // Stats summed over all moves
+
+    public:
+        explicit MctsStrategy(const MctsConfig &config = MctsConfig()) : searcher(config) {}
+
+        const char *name() const override { return "mcts"; }
+        std::shared_ptr<Strategy> clone() const override { return std::make_shared<MctsStrategy>(searcher.get_config()); } // Clones start with empty totals
+        Action choose_action(const Game &game, PlayerId self, SimRng &rng) override;
+        const MctsStats &last_stats() const { return searcher.last_stats(); } // Stats of the latest move
+        const MctsStats &total_stats() const { return total; }                // Stats summed over all moves
+    };
+
+}
@@ -0,0 +1,186 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "EventSink.hpp"
+#include "Game.hpp"
+#include "RoleFactory.hpp"
+#include "Varint.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace coup
+{
+
+    // Binary replay format. A log is any number of replays appended back to back.
+    //
+    //   header : 'C' 'R' version, varint seed, varint stream, varint seats,
+    //            then per seat: role byte, varint name length, name bytes
+    //   record : one byte, low nibble = event type, high nibble = target + 1
+    //            (0 = no target, 15 = varint target follows); reactions (undo
+    //            and peek) are followed by a varint actor, turn actions and
+    //            passes take the current player as actor
+    //   keyframe (version 2+): byte 0x0E, varint length, the game state between two
+    //            moves against the state before the first move. Version 4 lists the
+    //            rule fields (replay::state_fields) as runs of (varint unchanged
+    //            fields, varint changed fields, changed values as varints); versions
+    //            2 and 3 held raw GameState bytes XORed with the base
+    //   footer : byte 0x0F, varint record count, final Zobrist hash (8 bytes, little-endian)
+    //   index (version 2+): varint keyframe count, per keyframe varint record and
+    //            varint byte offset (both as deltas from the previous keyframe),
+    //            then the byte length of footer and index as 4 bytes little-endian,
+    //            so a reader holding one replay can find the index from its end
+    //
+    // Amounts, turn numbers and derived events (arrest unblocks, winner changes) are
+    // not stored: re-executing the moves reproduces them.
+    //
+    // Older versions are still read. Their records and footers are unchanged, but
+    // their keyframes are not: versions 2 and 3 stored raw GameState bytes, tied to
+    // the struct layout of the build that wrote them. Keyframes of older versions
+    // are stepped over, neither checked nor used to seek. Version 1 has no keyframes
+    // and no index.
+    namespace replay
+    {
+        constexpr std::uint8_t kVersion = 4;           // Format version written in every header (bumped whenever keyframes change)
+        constexpr std::uint8_t kOldestVersion = 1;     // Oldest version still read
+        constexpr std::uint8_t kIndexVersion = 2;      // First version with keyframes and an index
+        constexpr std::uint8_t kKeyframeMarker = 0x0E; // First byte of a keyframe
+        constexpr std::uint8_t kEndMarker = 0x0F;      // First byte of the footer
+        constexpr std::uint8_t kTargetEscape = 15;     // Target nibble meaning "varint target follows"
+        constexpr std::uint64_t kKeyframeEvery = 256;  // Default records between keyframes
+
+        std::uint64_t get_varint(const std::uint8_t *&at, const std::uint8_t *end); // read_varint that throws ReplayFormatException
+        constexpr std::size_t kStateFields = 7;    // Keyframe fields of the whole table
+        constexpr std::size_t kSeatFields = 11;    // Keyframe fields per seat
+        constexpr std::size_t kMaxStateFields = kStateFields + kSeatFields * kMaxPlayers; // Keyframe fields of the largest table
+
+        std::size_t state_fields(const GameState &state, std::uint64_t *values);    // List the rule fields of state in keyframe order; returns their number
+        void set_state_fields(GameState &state, const std::uint64_t *values);       // Inverse of state_fields (seats set), rebuilding derived indexes and the hash
+        void put_state(std::vector<std::uint8_t> &out, const GameState &state, const GameState &base); // Append state as runs of fields changed from base
+        void get_state(const std::uint8_t *&at, const std::uint8_t *end, const GameState &base, GameState &state); // Inverse of put_state
+    }
+
+    // One keyframe of a replay
+    struct ReplayKeyframe
+    {
+        std::uint64_t record = 0; // Moves played before it
+        std::size_t offset = 0;   // Byte offset of its marker from the start of the replay
+    };
+
+    // Writes finished replays to a stream on its own thread; the game threads only hand buffers over
+    class ReplayWriter
+    {
+    private:
+        std::ostream &out;                             // Destination (opened in binary mode)
+        std::vector<std::vector<std::uint8_t>> queue;  // Replays waiting to be written
+        std::vector<std::vector<std::uint8_t>> spare;  // Written buffers, kept for reuse
+        std::mutex lock;                               // Guards queue, spare and closing
+        std::condition_variable ready;                 // Signals queued work or closing
+        bool closing = false;                          // Set by close()
+        std::uint64_t replays = 0;                     // Replays written
+        std::uint64_t bytes = 0;                       // Bytes written
+        std::thread thread;                            // Writer thread
+
+        void loop(); // Thread body
+
+    public:
+        explicit ReplayWriter(std::ostream &out); // Starts the writer thread
+        ~ReplayWriter();                          // Writes what is left and stops
+        ReplayWriter(const ReplayWriter &) = delete;
+        ReplayWriter &operator=(const ReplayWriter &) = delete;
+
+        void submit(std::vector<std::uint8_t> &replay); // Queue a replay; replay is swapped with an empty buffer
+        void close();                                   // Write everything queued, flush and stop the thread
+
+        std::uint64_t replays_written() const { return replays; } // Replays written (exact after close)
+        std::uint64_t bytes_written() const { return bytes; }     // Bytes written (exact after close)
+    };
+
+    // Records one game at a time in the replay format; install it with Game::set_event_sink().
+    // Events arrive in the middle of a move, so keyframes are written only when the
+    // driver calls checkpoint() between moves.
+    class ReplaySink : public EventSink
+    {
+    private:
+        const Game *game = nullptr;             // Game being recorded (nullptr between games)
+        ReplayWriter *writer;                   // Receives finished replays (nullptr: keep them in bytes())
+        std::uint64_t keyframe_every;           // Records between keyframes (0 = none)
+        std::vector<std::uint8_t> buffer;       // Encoded replay
+        std::uint64_t records = 0;              // Records of the current replay
+        GameState initial;                      // State before the first move (keyframe base)
+        std::vector<ReplayKeyframe> keyframes;  // Keyframes of the current replay
+
+    public:
+        explicit ReplaySink(ReplayWriter *writer = nullptr, std::uint64_t keyframe_every = replay::kKeyframeEvery); // Constructor
+
+        void begin(const Game &game, std::uint64_t seed, std::uint64_t stream = 0); // Write the header (players seated, no move played yet)
+        void on_event(const GameEvent &event) override;                            // Append a move record
+        void checkpoint();                                                         // Between moves: write a keyframe if one is due
+        void finish();                                                             // Write the footer and index and hand the replay over
+
+        const std::vector<std::uint8_t> &bytes() const { return buffer; } // The replay, when there is no writer
+        std::uint64_t record_count() const { return records; }            // Records of the current replay
+        std::size_t keyframe_count() const { return keyframes.size(); }  // Keyframes of the current replay
+    };
+
+    // What a replay header and footer say
+    struct ReplayInfo
+    {
+        std::uint8_t version = replay::kVersion; // Format version of the replay
+        std::uint64_t seed = 0;         // Seed of the recorded game
+        std::uint64_t stream = 0;       // Random stream (game number) of the recorded game
+        std::vector<RoleId> roles;      // Role per seat
+        std::vector<std::string> names; // Name per seat
+        std::uint64_t records = 0;      // Moves replayed
+        std::uint64_t hash = 0;         // Final position hash (verified)
+        std::size_t bytes = 0;          // Encoded size
+    };
+
+    // Where one replay sits inside a log
+    struct ReplaySpan
+    {
+        const std::uint8_t *data = nullptr; // First byte
+        std::size_t size = 0;               // Length in bytes
+    };
+
+    // Reads a replay log and re-executes each replay through Game
+    class ReplayReader
+    {
+    private:
+        const std::uint8_t *at;  // Next unread byte
+        const std::uint8_t *end; // End of the log
+
+    public:
+        ReplayReader(const std::uint8_t *data, std::size_t size); // Reader over a whole log in memory
+
+        bool done() const { return at == end; } // No replay left
+        ReplayInfo next(Game &game);            // Seat the players in an empty game and replay every move (throws on mismatch)
+        ReplaySpan skip();                      // Step over the next replay without playing it
+    };
+
+    // Random access to the moves of one replay through its keyframe index
+    class ReplaySeeker
+    {
+    private:
+        ReplaySpan span;                       // The replay
+        ReplayInfo header;                     // Its header and footer
+        std::size_t body = 0;                  // Offset of the first record
+        std::vector<ReplayKeyframe> keyframes; // Its index, by record
+        GameState base;                        // State before the first move (keyframe base)
+
+        void read_index(const std::uint8_t *&at, const std::uint8_t *end); // Footer and keyframe index, found from the end
+
+    public:
+        explicit ReplaySeeker(const ReplaySpan &span); // Read the header and the index (throws ReplayFormatException)
+        explicit ReplaySeeker(const std::vector<std::uint8_t> &replay) : ReplaySeeker(ReplaySpan{replay.data(), replay.size()}) {} // Over ReplaySink::bytes()
+
+        const ReplayInfo &info() const { return header; }                              // Header, move count and final hash
+        const std::vector<ReplayKeyframe> &get_keyframes() const { return keyframes; } // The index
+        std::uint64_t seek(Game &game, std::uint64_t record) const; // Put game right before move `record`; returns the moves replayed to get there
+    };
+
+}
@@ -0,0 +1,56 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace coup
+{
+
+    // Counter-based random engine: the n-th number of a stream is a pure function of
+    // (key, n), two SplitMix64 finalizer rounds keyed by the stream. There is no hidden
+    // state to share, so any number of threads can draw from their own streams, a stream
+    // can be jumped to any position in O(1), and every result depends on the seed only.
+    // Satisfies UniformRandomBitGenerator, so it also works with <random> distributions.
+    class CounterRng
+    {
+    private:
+        std::uint64_t key = 0;     // Identifies the stream
+        std::uint64_t counter = 0; // Position in the stream
+
+        static constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ULL; // Weyl increment of SplitMix64
+
+    public:
+        using result_type = std::uint64_t;
+
+        static constexpr std::uint64_t mix(std::uint64_t z) // SplitMix64 finalizer
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+        static constexpr std::uint64_t at(std::uint64_t key, std::uint64_t n) // Number n of stream key
+        {
+            return mix(mix(key + n * kGolden) ^ (key >> 32 | key << 32));
+        }
+
+        CounterRng() = default;                                                      // Stream 0 of seed 0
+        explicit CounterRng(std::uint64_t seed, std::uint64_t stream = 0) { this->seed(seed, stream); } // Stream of a seed
+
+        void seed(std::uint64_t seed, std::uint64_t stream = 0) { key = mix(mix(seed) + stream * kGolden); counter = 0; } // Restart on another stream
+        CounterRng split(std::uint64_t stream) const { return CounterRng(key, stream); } // Independent child stream
+
+        result_type operator()() { return at(key, counter++); } // Next number
+        double uniform() { return ((*this)() >> 11) * 0x1.0p-53; } // Next number in [0, 1), the same on every platform
+        void discard(std::uint64_t count) { counter += count; } // Skip count numbers
+        std::uint64_t position() const { return counter; }      // Numbers drawn so far
+        void seek(std::uint64_t position) { counter = position; } // Jump to any position
+
+        static constexpr result_type min() { return 0; }                                           // Smallest output
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); } // Largest output
+
+        bool operator==(const CounterRng &other) const { return key == other.key && counter == other.counter; }
+        bool operator!=(const CounterRng &other) const { return !(*this == other); }
+    };
+
+}
@@ -0,0 +1,80 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Strategy.hpp"
+#include "Replay.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace coup
+{
+
+    // Settings for a batch of headless games
+    struct SimConfig
+    {
+        std::size_t games = 1000;       // Number of games to play
+        std::size_t players = 6;        // Seats per game (used when roles is empty)
+        std::size_t max_turns = 1000;   // Turn cap per game, reaching it counts as a draw
+        std::uint64_t seed = 1;         // Seed for role assignment and strategies
+        std::vector<std::string> roles; // Fixed roster roles; empty means random roles every game
+    };
+
+    // Outcome of a single game
+    struct GameResult
+    {
+        int winner = -1;         // Winning seat, -1 on a draw
+        std::size_t turns = 0;   // Turns played
+        std::size_t actions = 0; // Successful actions, including reactions
+    };
+
+    // Aggregated outcome of a batch
+    struct SimStats
+    {
+        std::size_t games = 0;         // Games played
+        std::size_t draws = 0;         // Games that hit the turn cap
+        std::size_t actions = 0;       // Successful actions over all games
+        double seconds = 0;            // Wall time of the batch
+        std::vector<std::size_t> wins; // Wins per seat
+
+        double games_per_second() const { return seconds > 0 ? games / seconds : 0; }     // Game throughput
+        double actions_per_second() const { return seconds > 0 ? actions / seconds : 0; } // Action throughput
+    };
+
+    // Plays complete games between pluggable strategies without any GUI
+    class SimEngine
+    {
+    private:
+        struct Worker; // Per-thread strategies and reusable table (defined in SimEngine.cpp)
+
+        SimConfig config;                                 // Batch settings
+        std::vector<std::shared_ptr<Strategy>> strategies; // Strategy per seat
+        std::vector<std::string> names;                   // Seat names, built once
+        std::vector<RoleId> roster;                       // Fixed roles per seat (empty = random)
+        std::vector<std::unique_ptr<Worker>> workers;     // Pool workers, kept between batches
+        ReplayWriter *recorder = nullptr;                 // Receives a replay of every batch game (not owned)
+        std::uint64_t keyframe_every = replay::kKeyframeEvery; // Records between replay keyframes
+
+        void draw_roles(SimRng &rng, RoleId roles[]) const; // Roles of the next game
+        GameResult play(Game &game, const std::vector<std::shared_ptr<Strategy>> &seats, SimRng &rng,
+                        ReplaySink *recording = nullptr) const; // Play a seated game to the end
+        GameResult play_indexed(Worker &worker, std::size_t index) const; // Play game number index of the batch on a worker's reused table
+
+    public:
+        static bool apply(Game &game, const Action &action); // Run an action through the try_* Player API
+        static SimRng game_stream(std::uint64_t seed, std::size_t index) { return SimRng(seed, index); } // Random stream of game number index of a batch
+
+        explicit SimEngine(const SimConfig &config); // Constructor (all seats start as RandomStrategy)
+        ~SimEngine();                                // Destructor
+
+        void set_strategy(std::size_t seat, const std::shared_ptr<Strategy> &strategy); // Replace a seat's strategy
+        void record_to(ReplayWriter *writer, std::uint64_t keyframe_every = replay::kKeyframeEvery); // Record every game of run() to writer (nullptr stops recording)
+        std::size_t seats() const { return strategies.size(); }                          // Number of seats
+
+        GameResult play_game(SimRng &rng); // Play one full game
+        SimStats run();                       // Play the whole batch and time it
+        SimStats run(WorkStealingPool &pool); // Same on a thread pool, with the same results for any thread count
+    };
+
+}
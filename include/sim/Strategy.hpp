@@ -0,0 +1,55 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Action.hpp"
+#include "Game.hpp"
+#include "Rng.hpp"
+#include <memory>
+
+namespace coup
+{
+
+    using SimRng = CounterRng; // Random engine used by the simulation
+
+    // Decision policy for one seat in a headless game
+    class Strategy
+    {
+    public:
+        virtual ~Strategy() = default;
+
+        virtual const char *name() const = 0; // Strategy name for reports
+        virtual std::shared_ptr<Strategy> clone() const = 0; // Fresh copy with the same settings, for another thread
+
+        // Choose a move for seat `self` on its own turn
+        virtual Action choose_action(const Game &game, PlayerId self, SimRng &rng) = 0;
+
+        // Optionally react out of turn after `last` was played; return false to pass
+        virtual bool choose_reaction(const Game &game, PlayerId self, const Action &last, SimRng &rng, Action &out);
+    };
+
+    // Picks uniformly among the moves that look affordable, reacts with a fixed probability
+    class RandomStrategy : public Strategy
+    {
+    private:
+        double reaction_chance; // Probability of using a role ability when one is available
+
+    public:
+        explicit RandomStrategy(double reaction_chance = 0.1) : reaction_chance(reaction_chance) {}
+
+        const char *name() const override { return "random"; }
+        std::shared_ptr<Strategy> clone() const override { return std::make_shared<RandomStrategy>(*this); }
+        Action choose_action(const Game &game, PlayerId self, SimRng &rng) override;
+        bool choose_reaction(const Game &game, PlayerId self, const Action &last, SimRng &rng, Action &out) override;
+    };
+
+    // Coups the richest opponent as soon as possible, otherwise builds coins as fast as it can
+    class GreedyStrategy : public Strategy
+    {
+    public:
+        const char *name() const override { return "greedy"; }
+        std::shared_ptr<Strategy> clone() const override { return std::make_shared<GreedyStrategy>(); }
+        Action choose_action(const Game &game, PlayerId self, SimRng &rng) override;
+        bool choose_reaction(const Game &game, PlayerId self, const Action &last, SimRng &rng, Action &out) override;
+    };
+
+}
@@ -0,0 +1,66 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coup
+{
+
+    // Fixed set of threads that runs batches of independent tasks, numbered 0..n-1.
+    // Each worker owns a deque of task numbers, kept as a contiguous range: the owner
+    // pops from the back, and an idle worker steals the older half from the front of
+    // another worker's deque. The calling thread takes part as worker 0.
+    class WorkStealingPool
+    {
+    public:
+        using Body = std::function<void(std::size_t worker, std::size_t task)>; // One task, told which worker runs it
+
+    private:
+        struct alignas(64) Deque
+        {
+            std::mutex lock;       // Guards the range
+            std::size_t begin = 0; // Oldest task (stolen first)
+            std::size_t end = 0;   // One past the newest task (popped first)
+        };
+
+        std::vector<std::thread> helpers;       // Workers 1..n-1
+        std::unique_ptr<Deque[]> deques;        // One deque per worker
+        std::size_t workers;                    // Worker count, including the caller
+        const Body *body = nullptr;             // Task of the running batch
+        std::atomic<std::size_t> remaining{0};  // Tasks not finished yet
+        std::atomic<std::size_t> steal_count{0}; // Steals during the latest batch
+        std::exception_ptr failure;             // First exception thrown by a task
+
+        std::mutex control;                 // Guards the batch hand-off below
+        std::condition_variable wake;       // Signals a new batch or shutdown
+        std::condition_variable done;       // Signals that the helpers left the batch
+        std::size_t generation = 0;         // Batches started
+        std::size_t busy = 0;               // Helpers still inside the batch
+        bool stopping = false;              // Set by the destructor
+
+        bool pop(std::size_t worker, std::size_t &task);   // Take the newest task of a worker's own deque
+        bool steal(std::size_t worker, std::size_t &task); // Move half of another deque into worker's own
+        void drain(std::size_t worker);                    // Run tasks until the batch is finished
+        void helper_loop(std::size_t worker);              // Thread body of workers 1..n-1
+
+    public:
+        explicit WorkStealingPool(std::size_t threads = 0); // Constructor (0 = one worker per hardware thread)
+        ~WorkStealingPool();                                // Destructor (joins the helpers)
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        std::size_t size() const { return workers; } // Worker count, including the caller
+
+        void run(std::size_t tasks, const Body &task_body); // Run tasks 0..tasks-1 and wait for all of them
+        std::size_t steals() const { return steal_count.load(std::memory_order_relaxed); } // Steals during the latest batch
+    };
+
+}
@@ -0,0 +1,92 @@
+// Author: noapatito123@gmail.com
+#pragma once
+
+#include "Action.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace coup
+{
+
+    // How a stored value relates to the true value of the position
+    enum class TTBound : std::uint8_t
+    {
+        None,  // No value, only a best move
+        Exact, // The value itself
+        Lower, // The true value is at least this
+        Upper  // The true value is at most this
+    };
+
+    // What a search remembers about one position
+    struct TTData
+    {
+        std::int16_t value = 0;                            // Score (scale chosen by the search)
+        std::uint8_t depth = 0;                            // Search depth or visit bucket; deeper entries are kept longer
+        TTBound bound = TTBound::None;                     // Meaning of value
+        Action best{ActionKind::Count, kNoPlayer, kNoTarget}; // Best move found (kind Count if none)
+    };
+
+    // Table usage counters, summed over all threads
+    struct TTStats
+    {
+        std::uint64_t hits = 0;       // Probes that found their position
+        std::uint64_t misses = 0;     // Probes that did not (including torn entries)
+        std::uint64_t stores = 0;     // Entries written
+        std::uint64_t collisions = 0; // Stores that evicted a different position
+    };
+
+    // Fixed-size hash table of search results shared by all search threads without locks.
+    // Each entry is two atomic words, data and key ^ data: a reader that sees halves of two
+    // different writes fails the XOR check and treats the entry as a miss.
+    class TranspositionTable
+    {
+    public:
+        static constexpr std::size_t kClusterSize = 4; // Entries per cache line
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> check{0}; // key ^ data
+            std::atomic<std::uint64_t> data{0};  // Packed TTData and generation (0 = empty)
+        };
+
+        struct alignas(64) Cluster
+        {
+            Entry entries[kClusterSize]; // Entries sharing one index
+        };
+
+        struct alignas(64) Counters
+        {
+            std::atomic<std::uint64_t> hits{0};       // See TTStats
+            std::atomic<std::uint64_t> misses{0};     // See TTStats
+            std::atomic<std::uint64_t> stores{0};     // See TTStats
+            std::atomic<std::uint64_t> collisions{0}; // See TTStats
+        };
+
+        static constexpr std::size_t kCounterStripes = 64; // Threads spread their counters over this many cache lines
+
+        std::vector<Cluster> clusters;             // The table (power-of-two length)
+        std::size_t mask;                          // clusters.size() - 1
+        std::atomic<std::uint8_t> generation{1};   // Current search generation (1..63)
+        mutable Counters counters[kCounterStripes]; // Striped usage counters
+
+        Counters &local_counters() const; // Counter stripe of the calling thread
+
+    public:
+        explicit TranspositionTable(std::size_t megabytes); // Allocate the largest power-of-two table that fits
+
+        bool probe(std::uint64_t key, TTData &out) const; // Look a position up (safe from any thread)
+        void store(std::uint64_t key, const TTData &data); // Remember a position (safe from any thread)
+
+        void new_search(); // Age every entry so older searches are replaced first
+        void clear();      // Empty the table and counters (not safe while other threads use it)
+
+        std::size_t entry_count() const { return clusters.size() * kClusterSize; } // Number of entries
+        std::size_t size_bytes() const { return clusters.size() * sizeof(Cluster); } // Memory used by entries
+        TTStats stats() const; // Counters summed over all threads
+        void reset_stats();    // Zero the counters
+    };
+
+}
@@ -0,0 +1,75 @@
+// Author: noapatito123@gmail.com
+#include "Ismcts.hpp"
+#include "SimEngine.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Usage: ./Sim [games] [players] [seed] [random|greedy|mixed|mcts|ismcts] [playouts] [threads]
+// mcts / ismcts put a search bot in seat 0 against the mixed lineup (ismcts does not see hidden coins)
+int main(int argc, char *argv[])
+{
+    coup::SimConfig config;
+    if (argc > 1)
+        config.games = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2)
+        config.players = std::strtoull(argv[2], nullptr, 10);
+    if (argc > 3)
+        config.seed = std::strtoull(argv[3], nullptr, 10);
+    const char *mode = argc > 4 ? argv[4] : "mixed";
+
+    if (config.players < 2 || config.players > coup::kMaxPlayers)
+    {
+        std::cerr << "players must be between 2 and " << coup::kMaxPlayers << std::endl;
+        return 1;
+    }
+
+    config.max_turns = std::max<std::size_t>(config.max_turns, config.players * 200); // Large tables need longer games
+
+    coup::SimEngine engine(config);
+    bool ismcts = std::strcmp(mode, "ismcts") == 0;
+    bool mcts = std::strcmp(mode, "mcts") == 0 || ismcts;
+    for (std::size_t seat = 0; seat < engine.seats(); ++seat)
+    {
+        bool greedy = std::strcmp(mode, "greedy") == 0 || ((std::strcmp(mode, "mixed") == 0 || mcts) && seat % 2 == 1);
+        if (greedy)
+            engine.set_strategy(seat, std::make_shared<coup::GreedyStrategy>());
+    }
+    const coup::MctsStats *bot = nullptr;
+    if (mcts)
+    {
+        coup::MctsConfig search;
+        search.playouts = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 500;
+        search.threads = argc > 6 ? std::strtoull(argv[6], nullptr, 10) : 1;
+        if (ismcts)
+        {
+            auto strategy = std::make_shared<coup::IsmctsStrategy>(search);
+            bot = &strategy->total_stats();
+            engine.set_strategy(0, strategy);
+        }
+        else
+        {
+            auto strategy = std::make_shared<coup::MctsStrategy>(search);
+            bot = &strategy->total_stats();
+            engine.set_strategy(0, strategy);
+        }
+    }
+
+    coup::SimStats stats = engine.run();
+
+    std::cout << "games:       " << stats.games << " (" << stats.draws << " draws)\n"
+              << "actions:     " << stats.actions << "\n"
+              << "time:        " << stats.seconds << " s\n"
+              << "games/sec:   " << stats.games_per_second() << "\n"
+              << "actions/sec: " << stats.actions_per_second() << "\n"
+              << "wins by seat:";
+    for (std::size_t wins : stats.wins)
+        std::cout << " " << wins;
+    std::cout << std::endl;
+    if (bot)
+        std::cout << mode << ":" << std::string(12 - std::strlen(mode), ' ') << bot->searches << " moves, "
+                  << bot->playouts_per_second() << " playouts/sec" << std::endl;
+    return 0;
+}
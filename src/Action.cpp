@@ -0,0 +1,73 @@
+// Author: noapatito123@gmail.com
+#include "Action.hpp"
+
+namespace coup
+{
+
+    /**
+     * @brief Returns a human-readable name for an action kind.
+     * @param kind The action kind.
+     * @return const char* Static action name.
+     */
+    const char *action_name(ActionKind kind)
+    {
+        switch (kind)
+        {
+        case ActionKind::Gather:
+            return "gather";
+        case ActionKind::Tax:
+            return "tax";
+        case ActionKind::Bribe:
+            return "bribe";
+        case ActionKind::Invest:
+            return "invest";
+        case ActionKind::Arrest:
+            return "arrest";
+        case ActionKind::Sanction:
+            return "sanction";
+        case ActionKind::Coup:
+            return "coup";
+        case ActionKind::UndoTax:
+            return "undo-tax";
+        case ActionKind::UndoBribe:
+            return "undo-bribe";
+        case ActionKind::UndoCoup:
+            return "undo-coup";
+        case ActionKind::PeekAndDisable:
+            return "peek and disable";
+        default:
+            return "unknown";
+        }
+    }
+
+    /**
+     * @brief Checks whether an action kind requires a target player.
+     * @param kind The action kind.
+     * @return true if the action is aimed at another player.
+     */
+    bool is_targeted(ActionKind kind)
+    {
+        return kind == ActionKind::Arrest || kind == ActionKind::Sanction || kind == ActionKind::Coup ||
+               kind == ActionKind::UndoBribe || kind == ActionKind::UndoCoup || kind == ActionKind::PeekAndDisable;
+    }
+
+    /**
+     * @brief Returns a short name for an action status.
+     * @param status The status.
+     * @return const char* Static status name.
+     */
+    const char *status_name(ActionStatus status)
+    {
+        static const char *const names[] = {
+            "ok", "game not started", "not your turn", "must coup", "sanctioned", "not enough coins",
+            "arrest blocked", "invalid target", "cannot target yourself", "target eliminated",
+            "target already eliminated", "target not eliminated", "duplicate arrest", "target has no coins",
+            "already sanctioned", "player eliminated", "ability used", "not undoable", "cannot undo own action",
+            "action too old", "no recent action", "no coup to undo", "invalid bribe undo"};
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<std::size_t>(ActionStatus::Count),
+                      "every ActionStatus needs a name");
+        std::size_t index = static_cast<std::size_t>(status);
+        return index < static_cast<std::size_t>(ActionStatus::Count) ? names[index] : "unknown";
+    }
+
+}
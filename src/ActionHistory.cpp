@@ -0,0 +1,51 @@
+// Author: noapatito123@gmail.com
+#include "ActionHistory.hpp"
+
+namespace coup
+{
+
+    /**
+     * @brief Appends an entry; when the buffer is full the oldest entry is
+     *        handed to the spill hook (if any) and overwritten.
+     * @param entry The action to log.
+     */
+    void ActionHistory::push(const HistoryEntry &entry)
+    {
+        if (count < kCapacity)
+            count++;
+        else if (spill)
+            spill((*this)[0]);
+        entries[total % kStorage] = entry;
+        total++;
+    }
+
+    /**
+     * @brief Takes back the newest entries, as if they had never been pushed.
+     *
+     * Entries they evicted come back as long as no more than kSlack pushes have
+     * been taken back; a deeper rewind keeps fewer entries. The spill hook is not
+     * told, so an entry evicted again after the rewind is handed to it again.
+     *
+     * @param to_total Entries ever pushed to go back to (total_pushed() at that point).
+     */
+    void ActionHistory::rewind(std::uint64_t to_total)
+    {
+        if (to_total >= total)
+            return;
+        std::uint64_t oldest = to_total > kCapacity ? to_total - kCapacity : 0; // First entry kept at that point
+        if (total > kStorage && oldest < total - kStorage)
+            oldest = total - kStorage; // Overwritten since
+        count = to_total > oldest ? static_cast<std::size_t>(to_total - oldest) : 0;
+        total = to_total;
+    }
+
+    /**
+     * @brief Drops every kept entry without spilling them.
+     */
+    void ActionHistory::clear()
+    {
+        count = 0;
+        total = 0;
+    }
+
+}
@@ -66,10 +66,10 @@ bool Button::contains(float x, float y) const {
 }
 
 /**
- * @brief Executes the assigned action if it exists.
+ * @brief Executes the assigned action if it exists and the button is enabled.
  */
 void Button::execute() {
-    if (action) {
+    if (action && enabled) {
         action();
     }
 }
@@ -82,3 +82,14 @@ void Button::execute() {
 const std::string& Button::getLabel() const {
     return labelText;
 }
+
+/**
+ * @brief Enables the button, or greys it out so clicks are ignored.
+ *
+ * @param value true to enable the button.
+ */
+void Button::setEnabled(bool value) {
+    enabled = value;
+    shape.setFillColor(value ? sf::Color(200, 200, 200) : sf::Color(235, 235, 235));
+    label.setFillColor(value ? sf::Color::Black : sf::Color(150, 150, 150));
+}
@@ -0,0 +1,234 @@
+// Author: noapatito123@gmail.com
+#include "EventSink.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace coup
+{
+
+    /**
+     * @brief Constructs a text sink writing to a stream.
+     * @param game The game whose player names are printed.
+     * @param out The destination stream.
+     * @param capacity Buffer size in bytes; 0 writes every line straight through.
+     */
+    TextSink::TextSink(const Game &game, std::ostream &out, std::size_t capacity)
+        : game(game), out(out), buffer(capacity), used(0) {}
+
+    /**
+     * @brief Flushes pending text before the sink goes away.
+     */
+    TextSink::~TextSink()
+    {
+        flush();
+    }
+
+    /**
+     * @brief Appends raw text, writing the buffer out whenever it fills up.
+     * @param text The characters to add.
+     * @param length How many characters to add.
+     */
+    void TextSink::append(const char *text, std::size_t length)
+    {
+        if (buffer.empty())
+        {
+            out.write(text, static_cast<std::streamsize>(length));
+            return;
+        }
+        while (length > 0)
+        {
+            if (used == buffer.size())
+            {
+                out.write(buffer.data(), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+            std::size_t chunk = std::min(length, buffer.size() - used);
+            std::memcpy(buffer.data() + used, text, chunk);
+            used += chunk;
+            text += chunk;
+            length -= chunk;
+        }
+    }
+
+    /**
+     * @brief Appends a null-terminated string.
+     * @param text The string to add.
+     */
+    void TextSink::append(const char *text)
+    {
+        append(text, std::strlen(text));
+    }
+
+    /**
+     * @brief Appends the name of a player, or "?" if the id is unknown.
+     * @param player The player's id.
+     */
+    void TextSink::append_name(PlayerId player)
+    {
+        const auto &players = game.get_all_players();
+        if (player >= players.size())
+        {
+            append("?", 1);
+            return;
+        }
+        const std::string &name = players[player]->get_name();
+        append(name.data(), name.size());
+    }
+
+    /**
+     * @brief Formats one event as a log line.
+     * @param event The event to print.
+     */
+    void TextSink::on_event(const GameEvent &event)
+    {
+        static const char *const verbs[] = {
+            "gather", "tax", "bribe", "invest", "arrest", "sanction", "coup",
+            "undo-tax", "undo-bribe", "undo-coup", "peek and disable"};
+
+        if (event.type == EventType::WinnerChanged && event.actor == kNoPlayer)
+        {
+            append("The game is no longer decided.\n");
+            if (buffer.empty())
+                out.flush();
+            return;
+        }
+
+        append_name(event.actor);
+        if (event.type == EventType::ArrestUnblocked)
+        {
+            append(" is no longer blocked from ARREST.\n");
+        }
+        else if (event.type == EventType::WinnerChanged)
+        {
+            append(" won the game!\n");
+        }
+        else if (event.type == EventType::TurnPassed)
+        {
+            append(" has no legal move and passes.\n");
+        }
+        else if (event.type < EventType::ArrestUnblocked)
+        {
+            append(" preformed ");
+            append(verbs[static_cast<int>(event.type)]);
+            if (event.target != kNoPlayer)
+            {
+                append(" on ");
+                append_name(event.target);
+            }
+            append("! \n\n");
+        }
+        else
+        {
+            append(" did something unknown.\n");
+        }
+        if (buffer.empty())
+            out.flush();
+    }
+
+    /**
+     * @brief Writes all pending text to the stream.
+     */
+    void TextSink::flush()
+    {
+        if (used > 0)
+        {
+            out.write(buffer.data(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+        out.flush();
+    }
+
+    /**
+     * @brief Constructs a binary sink writing to a stream.
+     * @param out The destination stream (should be opened in binary mode).
+     * @param capacity Buffer size in bytes, rounded down to whole records (at least one).
+     */
+    BinarySink::BinarySink(std::ostream &out, std::size_t capacity)
+        : out(out),
+          buffer(std::max(capacity / kRecordSize, std::size_t(1)) * kRecordSize),
+          used(0) {}
+
+    /**
+     * @brief Flushes pending records before the sink goes away.
+     */
+    BinarySink::~BinarySink()
+    {
+        flush();
+    }
+
+    /**
+     * @brief Buffers one encoded event, writing the buffer out when it is full.
+     * @param event The event to record.
+     */
+    void BinarySink::on_event(const GameEvent &event)
+    {
+        if (used == buffer.size())
+        {
+            out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+        encode(event, buffer.data() + used);
+        used += kRecordSize;
+    }
+
+    /**
+     * @brief Writes all pending records to the stream.
+     */
+    void BinarySink::flush()
+    {
+        if (used > 0)
+        {
+            out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+        out.flush();
+    }
+
+    /**
+     * @brief Encodes an event as a little-endian record of kRecordSize bytes.
+     *
+     * Layout: type, actor, target, reserved, amount (int32), turn (uint32).
+     *
+     * @param event The event to encode.
+     * @param record Destination of at least kRecordSize bytes.
+     */
+    void BinarySink::encode(const GameEvent &event, std::uint8_t *record)
+    {
+        std::uint32_t amount = static_cast<std::uint32_t>(event.amount);
+        record[0] = static_cast<std::uint8_t>(event.type);
+        record[1] = event.actor;
+        record[2] = event.target;
+        record[3] = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            record[4 + i] = static_cast<std::uint8_t>(amount >> (8 * i));
+            record[8 + i] = static_cast<std::uint8_t>(event.turn >> (8 * i));
+        }
+    }
+
+    /**
+     * @brief Decodes a record written by encode().
+     * @param record Source of at least kRecordSize bytes.
+     * @return GameEvent The decoded event.
+     */
+    GameEvent BinarySink::decode(const std::uint8_t *record)
+    {
+        std::uint32_t amount = 0;
+        std::uint32_t turn = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            amount |= static_cast<std::uint32_t>(record[4 + i]) << (8 * i);
+            turn |= static_cast<std::uint32_t>(record[8 + i]) << (8 * i);
+        }
+        GameEvent event;
+        event.type = static_cast<EventType>(record[0]);
+        event.actor = record[1];
+        event.target = record[2];
+        event.amount = static_cast<std::int32_t>(amount);
+        event.turn = turn;
+        return event;
+    }
+
+}
@@ -2,12 +2,12 @@
 #include "Game.hpp"
 #include "Player.hpp"
 #include "exceptions.hpp"
-#include <algorithm>
-#include <iostream>
+#include "Baron.hpp"
 #include "General.hpp"
-#include "Judge.hpp"
 #include "Governor.hpp"
+#include "Judge.hpp"
 #include "Spy.hpp"
+#include <algorithm>
 
 using namespace std;
 
@@ -16,9 +16,28 @@ namespace coup
 
     /**
      * @brief Constructs a new Game object with initial values.
+     * @param max_players Table size: how many players add_player accepts (default 6).
+     * @throws InvalidTableSizeException if max_players is 0 or above kMaxPlayers.
      */
-    Game::Game()
-        : turn_index(0), global_turn_index(0), current_round(1) {}
+    Game::Game(std::size_t max_players)
+        : state(), max_players(max_players)
+    {
+        if (max_players == 0 || max_players > kMaxPlayers)
+            throw InvalidTableSizeException(max_players, 0, kMaxPlayers);
+        state.hash = hash_state(state);
+    }
+
+    /**
+     * @brief Changes the table size for players added from now on.
+     * @param seats New table size.
+     * @throws InvalidTableSizeException if seats is 0, above kMaxPlayers or below the seated players.
+     */
+    void Game::set_max_players(std::size_t seats)
+    {
+        if (seats == 0 || seats > kMaxPlayers || seats < players_list.size())
+            throw InvalidTableSizeException(seats, players_list.size(), kMaxPlayers);
+        max_players = seats;
+    }
 
     /**
      * @brief Destructor for the Game class.
@@ -42,12 +61,39 @@ namespace coup
      */
     std::shared_ptr<Player> &Game::get_player(const string &name)
     {
-        for (std::shared_ptr<Player> &player : players_list)
-        {
-            if (player->get_name() == name)
-                return player;
-        }
-        throw PlayerNotFoundException(name);
+        PlayerId id = find_player_id(name);
+        if (id == kNoPlayer)
+            throw PlayerNotFoundException(name);
+        return players_list[id];
+    }
+
+    /**
+     * @brief Finds a player's index by name without throwing.
+     * @param name The name of the player to search.
+     * @return PlayerId The player's index, or kNoPlayer if there is no such player.
+     */
+    PlayerId Game::find_player_id(const std::string &name) const
+    {
+        auto it = player_ids.find(name);
+        return it == player_ids.end() ? kNoPlayer : it->second;
+    }
+
+    /**
+     * @brief Restores a state previously obtained from get_state().
+     *
+     * Players are not re-created: their state lives inside the GameState, so
+     * restoring is a plain copy of the used seats (copy_state). The state must
+     * come from a game with the same roster.
+     *
+     * @param saved The state to restore.
+     * @throws StateMismatchException if the state belongs to a different number of players.
+     */
+    void Game::set_state(const GameState &saved)
+    {
+        if (saved.player_count != players_list.size())
+            throw StateMismatchException();
+        copy_state(state, saved);
+        journal.clear(); // Marks taken before the jump no longer apply
     }
 
     /**
@@ -59,73 +105,81 @@ namespace coup
     {
         if (players_list.empty())
             throw NoPlayersLeftException();
-        return players_list[turn_index];
+        return players_list[state.turn_index];
     }
 
     /**
-     * @brief Counts the number of players still in the game.
-     * @return int Number of active (not eliminated) players.
+     * @brief Builds the legacy string view of the kept action log.
+     * @return std::vector<std::tuple<std::string, std::string, int>> (player, action, round), oldest first.
      */
-    int Game ::get_active_players_count() const
+    std::vector<std::tuple<std::string, std::string, int>> Game::get_action_history() const
     {
-        int count = 0;
-        for (const auto &p : players_list)
+        std::vector<std::tuple<std::string, std::string, int>> view;
+        view.reserve(history.size());
+        for (std::size_t i = 0; i < history.size(); ++i)
         {
-            if (!p->is_eliminated())
-            {
-                count++;
-            }
+            const HistoryEntry &entry = history[i];
+            view.emplace_back(players_list[entry.actor]->get_name(), action_name(entry.kind), static_cast<int>(entry.round));
         }
-        return count;
-    }
-
-    /**
-     * @brief Returns a reference to the map of tax turns.
-     * @return std::map<std::string, int>& Tax turn mapping.
-     */
-    std::map<std::string, int> &Game::get_tax_turns()
-    {
-        return tax_turns;
+        return view;
     }
 
     /**
      * @brief Gets the name of the last arrested player.
-     * @return const std::string& Name of the last arrested player.
+     * @return const std::string& Name of the last arrested player (empty if none).
      */
     const std::string &Game::get_last_arrested_name() const
     {
-        return last_arrested_name;
+        static const std::string none;
+        if (state.last_arrested == kNoPlayer)
+            return none;
+        return players_list[state.last_arrested]->get_name();
     }
 
     /**
-     * @brief Sets the name of the last arrested player.
-     * @param name Name to set.
+     * @brief Sets the last arrested player.
+     * @param name Name of the player.
+     * @throws PlayerNotFoundException if the player does not exist.
      */
     void Game::set_last_arrested_name(const std::string &name)
     {
-        last_arrested_name = name;
+        PlayerId id = find_player_id(name);
+        if (id == kNoPlayer)
+            throw PlayerNotFoundException(name);
+        set_last_arrested(id);
     }
 
     /**
      * @brief Adds a new player to the game.
      * @param const std::shared_ptr<Player> Pointer to the player to add.
-     * @throws MaxPlayersExceededException if more than 6 players.
+     * @throws MaxPlayersExceededException if the table (get_max_players()) is full.
      * @throws DuplicatePlayerNameException if name is already used.
+     *
+     * The player's name is interned into a dense PlayerId (its index) used by all bookkeeping.
      */
     void Game::add_player(const std::shared_ptr<Player> &player)
     {
-        if (players_list.size() >= 6)
+        if (players_list.size() >= max_players)
         {
-            throw MaxPlayersExceededException(); // limit reached
+            throw MaxPlayersExceededException(max_players); // limit reached
         }
-        for (const auto &p : players_list)
+        PlayerId id = static_cast<PlayerId>(players_list.size());
+        if (!player_ids.emplace(player->get_name(), id).second)
         {
-            if (p->get_name() == player->get_name())
-            {
-                throw DuplicatePlayerNameException(); // name already taken
-            }
+            throw DuplicatePlayerNameException(); // name already taken
         }
-        players_list.push_back(std::move(player));
+        player->attach(id, &state.players[id]); // player state now lives in the game state
+        state.player_count++;
+        state.hash ^= hash_player(state, id);
+        players_list.push_back(player);
+        if (!player->is_eliminated())
+            state.alive |= player_bit(id); // Seating players is not a winner change
+        PlayerId sanctioner = state.players[id].sanctioned_by;
+        if (player->is_sanctioned() && sanctioner < kMaxPlayers)
+            state.players[sanctioner].sanctions_by |= player_bit(id); // Sanction applied before joining
+        if (player->state->has(PlayerFlag::AbilityUsed))
+            state.abilities_used |= player_bit(id);
+        refresh_tax_window();
     }
 
     /**
@@ -140,17 +194,22 @@ namespace coup
      */
     void Game::remove_player(const std::string &target)
     {
-        for (auto &p : players_list)
-        {
-            if (p->get_name() == target)
-            {
-                p->mark_eliminated();
-                return;
-            }
-        }
-        throw PlayerNotFoundException(target);
-        if (turn_index >= players_list.size())
-            turn_index = 0;
+        PlayerId id = find_player_id(target);
+        if (id == kNoPlayer)
+            throw PlayerNotFoundException(target);
+        remove_player(id);
+    }
+
+    /**
+     * @brief Eliminates a player by id from the game.
+     * @param target The id of the player to eliminate.
+     * @throws PlayerNotFoundException if no player has that id (including kNoPlayer).
+     */
+    void Game::remove_player(PlayerId target)
+    {
+        if (target >= players_list.size())
+            throw PlayerNotFoundException("#" + std::to_string(target));
+        players_list[target]->mark_eliminated();
     }
 
     /**
@@ -158,33 +217,98 @@ namespace coup
      * @return string Player name.
      * @throws GameNotStartedException if no players are in the game.
      */
-    string Game::turn() const
+    const string &Game::turn() const
     {
         if (players_list.empty())
             throw GameNotStartedException();
-        return players_list[turn_index % players_list.size()]->get_name();
+        return players_list[state.turn_index % players_list.size()]->get_name();
     }
 
     /**
      * @brief Adds an entry to the coup list (attacker, target).
      * @param attacker Name of the attacking player.
      * @param target Name of the target player.
+     * @throws PlayerNotFoundException if either player does not exist.
      */
     void Game::add_to_coup(const std::string &attacker, const std::string &target)
     {
-        coup_list.emplace_back(attacker, target);
+        PlayerId attacker_id = find_player_id(attacker);
+        if (attacker_id == kNoPlayer)
+            throw PlayerNotFoundException(attacker);
+        PlayerId target_id = find_player_id(target);
+        if (target_id == kNoPlayer)
+            throw PlayerNotFoundException(target);
+        add_to_coup(attacker_id, target_id);
     }
 
+    /**
+     * @brief Checks whether a player has a coup against them that can still be undone.
+     * @param target_name Name of the target player.
+     * @return true if the player is in the coup list (unknown names are not).
+     */
     bool Game::is_in_coup_list(const std::string &target_name) const
     {
-        for (const auto &entry : coup_list)
-        {
-            if (entry.second == target_name)
-            {
-                return true;
-            }
-        }
-        return false;
+        PlayerId id = find_player_id(target_name);
+        return id != kNoPlayer && is_in_coup_list(id);
+    }
+
+    /**
+     * @brief Records a player's tax as the most recent one.
+     * @param player The player who taxed.
+     * @param amount The coins the tax gave.
+     */
+    void Game::record_tax(PlayerId player, int amount)
+    {
+        TaxRecord &record = state.players[player].last_tax;
+        std::int32_t before = tax_hash_value(record);
+        touch(record);
+        record.turn = state.global_turn_index;
+        record.amount = static_cast<std::int8_t>(amount);
+        record.undoable = true;
+        record.previous = state.latest_tax == player ? record.previous : state.latest_tax;
+        rehash(HashFeature::Tax, player, before, tax_hash_value(record));
+        rehash(HashFeature::LatestTax, 0, state.latest_tax, player);
+        touch(state.latest_tax);
+        state.latest_tax = player;
+        refresh_tax_window();
+    }
+
+    /**
+     * @brief Marks the latest tax as undone; the tax before it becomes the latest.
+     *
+     * A player keeps only their last tax, so a link to a record that has been
+     * overwritten by a newer tax (or already undone) ends the chain.
+     */
+    void Game::cancel_latest_tax()
+    {
+        if (state.latest_tax == kNoPlayer)
+            return;
+        TaxRecord &record = state.players[state.latest_tax].last_tax;
+        rehash(HashFeature::Tax, state.latest_tax, tax_hash_value(record), 0);
+        touch(record);
+        record.undoable = false;
+        PlayerId previous = record.previous;
+        bool older = previous != kNoPlayer && state.players[previous].last_tax.undoable &&
+                     state.players[previous].last_tax.turn < record.turn;
+        PlayerId latest = older ? previous : kNoPlayer;
+        rehash(HashFeature::LatestTax, 0, state.latest_tax, latest);
+        touch(state.latest_tax);
+        state.latest_tax = latest;
+        refresh_tax_window();
+    }
+
+    /**
+     * @brief Updates GameState::tax_window (and the hash) after the latest tax,
+     *        the turn counter or the number of living players changed.
+     */
+    void Game::refresh_tax_window()
+    {
+        bool open = tax_window_open(state);
+        if (open == state.tax_window)
+            return;
+        rehash(HashFeature::TaxWindow, 0, state.tax_window, open);
+        touch(state.tax_window);
+        state.tax_window = open;
     }
 
     /**
@@ -195,25 +319,128 @@ namespace coup
      */
     string Game::winner() const
     {
-        int alive_count = 0;
-        string winner_name;
-        for (const std::shared_ptr<coup::Player> &p : players_list)
-        {
-            if (!p->is_eliminated())
-            {
-                alive_count++;
-                winner_name = p->get_name(); // keep last found alive player
-            }
-        }
-        if (alive_count == 0)
+        if (state.alive == 0)
         {
             throw GameNotStartedException();
         }
-        else if (alive_count > 1)
+        else if (!is_game_over())
         {
             throw GameStillOngoingException();
         }
-        return winner_name;
+        return players_list[mask_first(state.alive)]->get_name();
+    }
+
+    /**
+     * @brief Updates the alive mask after a player is eliminated or revived.
+     *
+     * A WinnerChanged event is emitted each time the winner changes.
+     *
+     * @param player The player whose status changed.
+     * @param alive true if the player came back, false if they were eliminated.
+     */
+    void Game::set_alive(PlayerId player, bool alive)
+    {
+        PlayerId before = get_winner();
+        touch(state.alive);
+        if (alive)
+            state.alive |= player_bit(player);
+        else
+            state.alive &= ~player_bit(player);
+
+        refresh_tax_window();
+
+        PlayerId after = get_winner();
+        if (after != before)
+            emit(EventType::WinnerChanged, after);
+    }
+
+    /**
+     * @brief Lists the moves the current player may make right now.
+     * @return ActionSet Legal (action, target) pairs; empty if the game has no players.
+     */
+    ActionSet Game::legal_actions() const
+    {
+        return legal_actions(state.turn_index);
+    }
+
+    /**
+     * @brief Lists the moves a player may make right now, without throwing.
+     *
+     * Covers the regular actions when it is the player's turn and the role
+     * abilities that can be used out of turn (undo tax, undo bribe, undo coup,
+     * peek and disable). Every pair is checked with the same rules as try_*.
+     *
+     * @param actor The player whose moves are listed.
+     * @return ActionSet Legal (action, target) pairs.
+     */
+    ActionSet Game::legal_actions(PlayerId actor) const
+    {
+        ActionSet legal;
+        if (actor >= players_list.size())
+            return legal;
+        const Player &p = *players_list[actor];
+        const PlayerId count = state.player_count;
+
+        if (p.turn_status() == ActionStatus::Ok)
+        {
+            if (p.check_gather() == ActionStatus::Ok)
+                legal.add(ActionKind::Gather);
+            if (p.check_tax() == ActionStatus::Ok)
+                legal.add(ActionKind::Tax);
+            if (p.check_bribe() == ActionStatus::Ok)
+                legal.add(ActionKind::Bribe);
+            if (p.role_id() == RoleId::Baron && static_cast<const Baron &>(p).check_invest() == ActionStatus::Ok)
+                legal.add(ActionKind::Invest);
+            for (PlayerId target = 0; target < count; ++target)
+            {
+                if (p.check_arrest(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::Arrest, target);
+                if (p.check_sanction(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::Sanction, target);
+                if (p.check_coup(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::Coup, target);
+            }
+        }
+
+        switch (p.role_id())
+        {
+        case RoleId::Governor:
+            if (static_cast<const Governor &>(p).check_undo_tax() == ActionStatus::Ok)
+                legal.add(ActionKind::UndoTax);
+            break;
+        case RoleId::Judge:
+            for (PlayerId target = 0; target < count; ++target)
+                if (static_cast<const Judge &>(p).check_undo_bribe(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::UndoBribe, target);
+            break;
+        case RoleId::General:
+            for (PlayerId target = 0; target < count; ++target)
+                if (static_cast<const General &>(p).check_undo_coup(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::UndoCoup, target);
+            break;
+        case RoleId::Spy:
+            for (PlayerId target = 0; target < count; ++target)
+                if (static_cast<const Spy &>(p).check_peek_and_disable(target) == ActionStatus::Ok)
+                    legal.add(ActionKind::PeekAndDisable, target);
+            break;
+        default:
+            break;
+        }
+        return legal;
+    }
+
+    /**
+     * @brief Skips the turn of a player who has no legal move.
+     *
+     * Same as next_turn(), but reported as a TurnPassed event so that logs and
+     * replays see every turn change.
+     */
+    void Game::pass_turn()
+    {
+        if (players_list.empty())
+            return;
+        emit(EventType::TurnPassed, static_cast<PlayerId>(state.turn_index));
+        next_turn();
     }
 
     /**
@@ -233,53 +460,45 @@ namespace coup
             return; // player gets another turn
         }
 
-        // advance to next living player
-        do
-        {
-            turn_index = (turn_index + 1) % players_list.size();
-        } while (players_list[turn_index]->is_eliminated()); // skip non-active player
+        if (state.alive == 0)
+            return; // nobody left to play
 
-        global_turn_index++;
+        // advance to next living player (eliminated players are skipped)
+        PlayerId next = mask_next(state.alive, state.turn_index);
+        rehash(HashFeature::TurnIndex, 0, state.turn_index, next);
+        touch(state.turn_index);
+        state.turn_index = next;
 
-        // Find the smallest index of a living player
-        size_t min_alive_index = -1;
-        for (size_t i = 0; i < players_list.size(); ++i)
-        {
-            if (!players_list[i]->is_eliminated())
-            {
-                min_alive_index = i;
-                break;
-            }
-        }
+        touch(state.global_turn_index);
+        state.global_turn_index++;
+        refresh_tax_window();
 
         // If current player is the first living one in order → new round: reset flags for role-based undo abilities
-        if (turn_index == min_alive_index)
+        if (state.turn_index == mask_first(state.alive))
         {
-            current_round++;
-            for (std::shared_ptr<Player> &p : players_list)
+            touch(state.current_round);
+            state.current_round++;
+            // Only players who used their ability (Judge, Governor, General and Spy) are visited
+            touch(state.abilities_used);
+            for (PlayerMask used = state.abilities_used; used; used &= used - 1)
             {
-                if (p->role() == "Judge")
-                    static_cast<Judge *>(p.get())->reset_undo_bribe_flag();
-                if (p->role() == "Governor")
-                    static_cast<Governor *>(p.get())->reset_undo_tax_flag();
-                if (p->role() == "General")
-                    static_cast<General *>(p.get())->reset_undo_coup_flag();
-                if (p->role() == "Spy")
-                    static_cast<Spy *>(p.get())->reset_peek_and_disable_flag();
+                PlayerId i = mask_first(used);
+                PlayerState &p = state.players[i];
+                std::uint8_t before = p.flags;
+                touch(p.flags);
+                p.set(PlayerFlag::AbilityUsed, false);
+                rehash(HashFeature::Flags, i, before, p.flags);
             }
+            state.abilities_used = 0;
         }
 
-        std::shared_ptr<Player> &current = players_list[turn_index];
+        std::shared_ptr<Player> &current = players_list[state.turn_index];
 
         std::shared_ptr<Player> &prev_player = get_current_player();
 
         // remove coup records related to current turn player
-        coup_list.erase(std::remove_if(coup_list.begin(), coup_list.end(),
-                                       [this](const std::pair<std::string, std::string> &entry)
-                                       {
-                                           return entry.first == turn(); // clear only records of current player
-                                       }),
-                        coup_list.end());
+        for (PlayerMask targets = state.players[state.turn_index].coups_by; targets; targets &= targets - 1)
+            remove_from_coup_list(mask_first(targets)); // clear only records of current player
 
         current->start_new_turn(); // reset internal states for the new turn
 
@@ -290,7 +509,7 @@ namespace coup
             if (prev_player->get_disable_arrest_turns() == 0)
             {
                 prev_player->set_disable_to_arrest(false);
-                std::cout << prev_player->get_name() << " is no longer blocked from ARREST." << std::endl;
+                emit(EventType::ArrestUnblocked, prev_player->get_id());
             }
         }
     }
@@ -0,0 +1,241 @@
+// Author: noapatito123@gmail.com
+#include "Game.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "Varint.hpp"
+#include "exceptions.hpp"
+
+namespace coup
+{
+
+    namespace
+    {
+        constexpr std::uint8_t kSnapshotVersion = 2; // Layout written by Game::snapshot() (1 also carried observer coin bounds)
+
+        // FNV-1a over a byte range, the blob's trailing checksum
+        std::uint32_t checksum(const std::uint8_t *data, std::size_t size)
+        {
+            std::uint32_t sum = 2166136261u;
+            for (std::size_t i = 0; i < size; ++i)
+                sum = (sum ^ data[i]) * 16777619u;
+            return sum;
+        }
+
+        // Bounds-checked reads that throw SnapshotFormatException
+        struct Cursor
+        {
+            const std::uint8_t *at;  // Next unread byte
+            const std::uint8_t *end; // End of the blob
+
+            std::uint8_t byte()
+            {
+                if (at == end)
+                    throw SnapshotFormatException();
+                return *at++;
+            }
+            std::uint64_t varint()
+            {
+                std::uint64_t value;
+                if (!read_varint(at, end, value))
+                    throw SnapshotFormatException();
+                return value;
+            }
+            std::int64_t signed_varint() { return unzigzag(varint()); }
+            PlayerId player(std::size_t seats) // A seat or kNoPlayer
+            {
+                std::uint8_t id = byte();
+                if (id != kNoPlayer && id >= seats)
+                    throw SnapshotFormatException();
+                return id;
+            }
+        };
+    }
+
+    /**
+     * @brief Saves the game as a compact binary blob.
+     * @return std::vector<std::uint8_t> The blob (see snapshot(out) for the layout).
+     */
+    std::vector<std::uint8_t> Game::snapshot() const
+    {
+        std::vector<std::uint8_t> blob;
+        snapshot(blob);
+        return blob;
+    }
+
+    /**
+     * @brief Saves the game as a compact binary blob into a reused buffer.
+     *
+     * Layout (version 2): 'C' 'S' version, the roster (varint seats, then per seat
+     * role byte, varint name length, name), the turn counters, tax and arrest
+     * records, every field of every player (signed fields zigzag varints), the
+     * position hash (8 bytes, little-endian, checked against the decoded state)
+     * and an FNV-1a checksum of everything before it (4 bytes, little-endian).
+     * The action log is not included.
+     *
+     * @param out Receives the blob (cleared first; no allocation once it is large enough).
+     */
+    void Game::snapshot(std::vector<std::uint8_t> &out) const
+    {
+        out.clear();
+        out.push_back('C');
+        out.push_back('S');
+        out.push_back(kSnapshotVersion);
+        write_varint(out, players_list.size());
+        for (const std::shared_ptr<Player> &player : players_list)
+        {
+            out.push_back(static_cast<std::uint8_t>(player->role_id()));
+            write_varint(out, player->get_name().size());
+            out.insert(out.end(), player->get_name().begin(), player->get_name().end());
+        }
+
+        write_varint(out, state.global_turn_index);
+        write_varint(out, state.current_round);
+        out.push_back(state.turn_index);
+        out.push_back(state.last_arrested);
+        out.push_back(state.latest_tax);
+        out.push_back(state.tax_window ? 1 : 0);
+        write_varint(out, state.alive);
+        for (std::size_t i = 0; i < players_list.size(); ++i)
+        {
+            const PlayerState &p = state.players[i];
+            write_varint(out, zigzag(p.coins));
+            out.push_back(p.flags);
+            write_varint(out, zigzag(p.extra_turns));
+            write_varint(out, zigzag(p.disable_arrest_turns));
+            out.push_back(p.sanctioned_by);
+            write_varint(out, state.players[i].sanctions_by);
+            out.push_back(state.players[i].couped_by);
+            const TaxRecord &tax = state.players[i].last_tax;
+            write_varint(out, tax.turn);
+            write_varint(out, zigzag(tax.amount));
+            out.push_back(tax.undoable ? 1 : 0);
+            out.push_back(tax.previous);
+        }
+        for (int i = 0; i < 8; ++i)
+            out.push_back(static_cast<std::uint8_t>(state.hash >> (8 * i)));
+        std::uint32_t sum = checksum(out.data(), out.size());
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<std::uint8_t>(sum >> (8 * i)));
+    }
+
+    /**
+     * @brief Restores a blob written by snapshot().
+     *
+     * If the game already has the blob's players (same names and roles, in order),
+     * only the state is replaced: nothing is allocated and every Player object stays
+     * valid, so this is the cheap rollback path. An empty game gets the blob's
+     * players seated first (crash recovery). The action log is cleared.
+     * Version 1 blobs still load; the observer coin bounds they carry are skipped.
+     *
+     * @param data First byte of the blob.
+     * @param size Length of the blob.
+     * @throws SnapshotFormatException if the blob is truncated, corrupt or from another version.
+     * @throws StateMismatchException if the game has different players.
+     */
+    void Game::restore(const std::uint8_t *data, std::size_t size)
+    {
+        if (size < 4)
+            throw SnapshotFormatException();
+        std::uint32_t sum = 0;
+        for (int i = 0; i < 4; ++i)
+            sum |= static_cast<std::uint32_t>(data[size - 4 + i]) << (8 * i);
+        if (sum != checksum(data, size - 4))
+            throw SnapshotFormatException();
+
+        Cursor in{data, data + size - 4};
+        if (in.byte() != 'C' || in.byte() != 'S')
+            throw SnapshotFormatException();
+        std::uint8_t version = in.byte();
+        if (version == 0 || version > kSnapshotVersion)
+            throw SnapshotFormatException();
+        std::uint64_t seats = in.varint();
+        if (seats > kMaxPlayers || seats == 0)
+            throw SnapshotFormatException();
+
+        GameState loaded;
+        loaded.player_count = static_cast<std::uint8_t>(seats);
+        const std::uint8_t *roster = in.at;
+        for (std::uint64_t i = 0; i < seats; ++i)
+        {
+            std::uint8_t role = in.byte();
+            std::uint64_t length = in.varint();
+            if (role >= kRoleCount || length > static_cast<std::uint64_t>(in.end - in.at))
+                throw SnapshotFormatException();
+            loaded.players[i].role = static_cast<RoleId>(role);
+            in.at += length;
+        }
+
+        loaded.global_turn_index = static_cast<std::uint32_t>(in.varint());
+        loaded.current_round = static_cast<std::uint32_t>(in.varint());
+        loaded.turn_index = in.player(seats);
+        loaded.last_arrested = in.player(seats);
+        loaded.latest_tax = in.player(seats);
+        loaded.tax_window = in.byte() != 0;
+        loaded.alive = in.varint();
+        if (loaded.turn_index == kNoPlayer)
+            throw SnapshotFormatException();
+        for (std::size_t i = 0; i < seats; ++i)
+        {
+            PlayerState &p = loaded.players[i];
+            p.coins = static_cast<std::int16_t>(in.signed_varint());
+            p.flags = in.byte();
+            p.extra_turns = static_cast<std::int8_t>(in.signed_varint());
+            p.disable_arrest_turns = static_cast<std::int8_t>(in.signed_varint());
+            p.sanctioned_by = in.player(seats);
+            if (version == 1)
+            {
+                in.signed_varint(); // Observer coin bounds, no longer part of the rule state
+                in.signed_varint();
+                in.varint();
+            }
+            loaded.players[i].sanctions_by = in.varint();
+            loaded.players[i].couped_by = in.player(seats);
+            if (loaded.players[i].couped_by != kNoPlayer)
+                loaded.players[loaded.players[i].couped_by].coups_by |= player_bit(static_cast<PlayerId>(i)); // Derived indexes are not stored
+            if (p.has(PlayerFlag::AbilityUsed))
+                loaded.abilities_used |= player_bit(static_cast<PlayerId>(i));
+            TaxRecord &tax = loaded.players[i].last_tax;
+            tax.turn = static_cast<std::uint32_t>(in.varint());
+            tax.amount = static_cast<std::int8_t>(in.signed_varint());
+            tax.undoable = in.byte() != 0;
+            tax.previous = in.player(seats);
+        }
+        for (int i = 0; i < 8; ++i)
+            loaded.hash |= static_cast<std::uint64_t>(in.byte()) << (8 * i);
+        if (in.at != in.end || loaded.hash != hash_state(loaded))
+            throw SnapshotFormatException();
+
+        Cursor names{roster, in.end};
+        if (players_list.empty())
+        {
+            if (seats > max_players)
+                max_players = seats; // The recovered table keeps its size
+            for (std::uint64_t i = 0; i < seats; ++i)
+            {
+                RoleId role = static_cast<RoleId>(names.byte());
+                std::uint64_t length = names.varint();
+                add_player(create_player(*this, role, std::string(reinterpret_cast<const char *>(names.at), length)));
+                names.at += length;
+            }
+        }
+        else
+        {
+            if (players_list.size() != seats)
+                throw StateMismatchException();
+            for (std::uint64_t i = 0; i < seats; ++i)
+            {
+                RoleId role = static_cast<RoleId>(names.byte());
+                std::uint64_t length = names.varint();
+                const std::string &name = players_list[i]->get_name();
+                if (players_list[i]->role_id() != role || name.size() != length ||
+                    name.compare(0, length, reinterpret_cast<const char *>(names.at), length) != 0)
+                    throw StateMismatchException();
+                names.at += length;
+            }
+        }
+        copy_state(state, loaded);
+        journal.clear();
+        history.clear();
+    }
+
+}
@@ -0,0 +1,50 @@
+// Author: noapatito123@gmail.com
+#include "MoveJournal.hpp"
+#include "exceptions.hpp"
+
+namespace coup
+{
+
+    static_assert(sizeof(GameState) <= UINT16_MAX, "JournalEntry offsets are 16-bit");
+
+    /**
+     * @brief Starts logging writes, reserving room for `capacity` entries.
+     * @param capacity Entries to reserve; the log still grows past it if needed.
+     */
+    void MoveJournal::enable(std::size_t capacity)
+    {
+        entries.clear();
+        entries.reserve(capacity);
+        active = true;
+    }
+
+    /**
+     * @brief Stops logging; existing marks become invalid.
+     */
+    void MoveJournal::disable()
+    {
+        entries.clear();
+        active = false;
+    }
+
+    /**
+     * @brief Rolls the state back to a mark by replaying the saved fields in reverse.
+     * @param state The state the entries were logged against.
+     * @param to A mark taken on this journal since it was last enabled or cleared.
+     * @throws StateMismatchException if the mark is newer than the journal.
+     */
+    void MoveJournal::undo(GameState &state, const JournalMark &to)
+    {
+        if (to.entries > entries.size())
+            throw StateMismatchException();
+        char *base = reinterpret_cast<char *>(&state);
+        while (entries.size() > to.entries)
+        {
+            const JournalEntry &entry = entries.back();
+            std::memcpy(base + entry.offset, &entry.bytes, entry.size);
+            entries.pop_back();
+        }
+        state.hash = to.hash;
+    }
+
+}
@@ -3,27 +3,35 @@
 #include "exceptions.hpp"
 #include "Game.hpp"
 #include <memory>
-#include <iostream>
 
 namespace coup
 {
 
     /**
      * @brief Constructs a new Player object with default status and 0 coins.
+     *
+     * The player keeps its state locally until it is added to a game.
      */
-    Player::Player(Game &game, const std::string &name)
-        : eliminated(false),
-          disable_to_arrest(false),
+    Player::Player(Game &game, const std::string &name, RoleId role)
+        : id(kNoPlayer),
+          local(),
           game(game),
           name(name),
-          coins(0),
-          mustPerformCoup(false),
-          sanctioned(false),
-          extra_turns(0),
-          sanctioned_by(""),
-          disable_arrest_turns(0),
-          used_bribe(false)
+          state(&local)
     {
+        local.role = role;
+    }
+
+    /**
+     * @brief Moves the player's state into a slot of the game's state.
+     * @param slot_id The player's index in the game.
+     * @param slot The game-owned slot that becomes the player's state.
+     */
+    void Player::attach(PlayerId slot_id, PlayerState *slot)
+    {
+        *slot = *state;
+        state = slot;
+        id = slot_id;
     }
 
     /**
@@ -38,35 +46,77 @@ namespace coup
      */
     void Player::gather()
     {
-        check_turn();
+        ActionStatus status = try_gather();
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Gather);
+    }
+
+    /**
+     * @brief Checks whether gather is allowed right now.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_gather() const
+    {
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            return status;
         if (must_coup())
-            throw MustPerformCoupException();
-        if (is_sanctioned() == true)
-            throw SanctionedException();
-        coins++;
-        std::cout << name << " preformed gather! \n"
-                  << std::endl;
+            return ActionStatus::MustCoup;
+        if (is_sanctioned())
+            return ActionStatus::Sanctioned;
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Gathers 1 coin if the rules allow it.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_gather()
+    {
+        ActionStatus status = check_gather();
+        if (status != ActionStatus::Ok)
+            return status;
+        set_coins(state->coins + 1);
+        game.emit(EventType::Gather, id, kNoPlayer, 1);
         game.next_turn();
+        return ActionStatus::Ok;
     }
 
     /**
-     * @brief Performs the tax action (gain 2 coins and record the action).
+     * @brief Performs the tax action (gain 2 coins, 3 for a Governor, and record the action).
      * @throws MustPerformCoupException if player must coup.
      * @throws SanctionedException if player is sanctioned.
      */
     void Player::tax()
     {
-        check_turn();
-        if (must_coup())
-            throw MustPerformCoupException();
-        if (is_sanctioned() == true)
-            throw SanctionedException();
-        coins += 2;
-        game.get_action_history().emplace_back(name, "tax", game.get_current_round());
-        game.get_tax_turns()[name] = game.get_global_turn_index(); // Track tax turn
-        std::cout << name << " preformed tax! \n"
-                  << std::endl;
+        ActionStatus status = try_tax();
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Tax);
+    }
+
+    /**
+     * @brief Checks whether tax is allowed right now.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_tax() const
+    {
+        return check_gather(); // Same conditions: own turn, no pending coup, not sanctioned
+    }
+
+    /**
+     * @brief Collects tax if the rules allow it.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_tax()
+    {
+        ActionStatus status = check_tax();
+        if (status != ActionStatus::Ok)
+            return status;
+        set_coins(state->coins + traits().tax_amount);
+        game.record_tax(id, traits().tax_amount); // Remember it for undo_tax
+        game.emit(EventType::Tax, id, kNoPlayer, traits().tax_amount);
         game.next_turn();
+        return ActionStatus::Ok;
     }
 
     /**
@@ -76,60 +126,105 @@ namespace coup
      */
     void Player::bribe()
     {
-        check_turn();
+        ActionStatus status = try_bribe();
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Bribe);
+    }
+
+    /**
+     * @brief Checks whether bribe is allowed right now.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_bribe() const
+    {
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            return status;
         if (must_coup())
-            throw MustPerformCoupException();
-        if (coins < 4)
-            throw NotEnoughCoinsException(4, coins);
-        coins -= 4;        // Pay 4 coins
-        extra_turns = 2;   // Gain 2 extra turns
+            return ActionStatus::MustCoup;
+        if (state->coins < kBribeCost)
+            return ActionStatus::NotEnoughCoins;
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Bribes for extra turns if the rules allow it.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_bribe()
+    {
+        ActionStatus status = check_bribe();
+        if (status != ActionStatus::Ok)
+            return status;
+        set_coins(state->coins - kBribeCost); // Pay 4 coins
+        set_extra_turns(2); // Gain 2 extra turns
         mark_used_bribe(); // Set bribe used flag
-        std::cout << name << " preformed bribe! \n"
-                  << std::endl;
+        game.emit(EventType::Bribe, id, kNoPlayer, kBribeCost);
         game.next_turn();
+        return ActionStatus::Ok;
     }
 
     /**
      * @brief Arrests the target player and adjusts coins based on role.
+     *
+     * The target's role decides the effect (see RoleTraits): a General keeps
+     * their coin, a Merchant pays 2 coins to the bank, anyone else pays 1 to the attacker.
+     *
      * @throws Multiple exceptions for invalid arrest conditions.
      */
     void Player::arrest(const std::shared_ptr<Player> &target)
     {
-        check_turn();
+        ActionStatus status = try_arrest(target->id);
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Arrest, target.get());
+    }
+
+    /**
+     * @brief Checks whether arresting a player is allowed right now.
+     * @param target Id of the player to arrest.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_arrest(PlayerId target) const
+    {
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            return status;
         if (must_coup())
-            throw MustPerformCoupException();
+            return ActionStatus::MustCoup;
         if (is_disable_to_arrest())
-            throw ArrestBlockedException();
-        if (target->is_eliminated())
-            throw TargetIsEliminatedException();
-        if (target->get_name() == name)
-            throw CannotTargetYourselfException();
-        if (target->get_name() == game.get_last_arrested_name())
-            throw DuplicateArrestException();
+            return ActionStatus::ArrestBlocked;
+        const Player *victim = player_at(target);
+        if (victim == nullptr)
+            return ActionStatus::InvalidTarget;
+        if (victim->is_eliminated())
+            return ActionStatus::TargetEliminated;
+        if (target == id)
+            return ActionStatus::CannotTargetYourself;
+        if (target == game.get_last_arrested())
+            return ActionStatus::DuplicateArrest;
+        if (victim->state->coins < victim->traits().arrest_min_coins)
+            return ActionStatus::TargetNoCoins;
+        return ActionStatus::Ok;
+    }
 
-        if (target->role() == "General")
-        {
-            if (target->get_coins() <= 0)
-                throw TargetNoCoinsException();
-            coins++; // Steal 1 coin from General
-        }
-        else if (target->role() == "Merchant")
-        {
-            if (target->get_coins() <= 1)
-                throw TargetNoCoinsException();
-            target->coins -= 2; // Merchant loses 2 coins
-        }
-        else
-        {
-            if (target->get_coins() <= 0)
-                throw TargetNoCoinsException();
-            target->coins--; // Target loses 1 coin
-            coins++;         // Attacker gains 1 coin
-        }
-        game.set_last_arrested_name(target->get_name()); // Save last arrested
-        std::cout << name << " preformed arrest on " << target->get_name() << "! \n"
-                  << std::endl;
+    /**
+     * @brief Arrests a player if the rules allow it.
+     * @param target Id of the player to arrest.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_arrest(PlayerId target)
+    {
+        ActionStatus status = check_arrest(target);
+        if (status != ActionStatus::Ok)
+            return status;
+        Player *victim = player_at(target);
+        const RoleTraits &target_traits = victim->traits();
+        victim->set_coins(victim->state->coins - target_traits.arrest_loss); // Target pays
+        set_coins(state->coins + target_traits.arrest_gain); // Attacker collects
+        game.set_last_arrested(target); // Save last arrested
+        game.emit(EventType::Arrest, id, target, target_traits.arrest_gain);
         game.next_turn();
+        return ActionStatus::Ok;
     }
 
     /**
@@ -138,24 +233,58 @@ namespace coup
      */
     void Player::sanction(const std::shared_ptr<Player> &target)
     {
-        check_turn();
+        ActionStatus status = try_sanction(target->id);
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Sanction, target.get());
+    }
+
+    /**
+     * @brief Checks whether sanctioning a player is allowed right now.
+     * @param target Id of the player to sanction.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_sanction(PlayerId target) const
+    {
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            return status;
         if (must_coup())
-            throw MustPerformCoupException();
-        if (target->is_eliminated())
-            throw TargetIsEliminatedException();
-        if (target->get_name() == name)
-            throw CannotTargetYourselfException();
-        if (target->is_sanctioned() == true)
-            throw AlreadySanctionedException();
-        if (target->role() == "Baron")
-            target->increase_coins(1); // Baron gets 1 coin back
-        if ((target->role() == "Judge" && coins < 4) || coins < 3)
-            throw NotEnoughCoinsException(target->role() == "Judge" ? 4 : 3, coins);
-        target->role() == "Judge" ? coins -= 4 : coins -= 3; // Judge costs 4, others cost 3
-        target->mark_sanctioned(name);                       // Apply sanction
-        std::cout << name << " preformed sanction on " << target->get_name() << "! \n"
-                  << std::endl;
+            return ActionStatus::MustCoup;
+        const Player *victim = player_at(target);
+        if (victim == nullptr)
+            return ActionStatus::InvalidTarget;
+        if (victim->is_eliminated())
+            return ActionStatus::TargetEliminated;
+        if (target == id)
+            return ActionStatus::CannotTargetYourself;
+        if (victim->is_sanctioned())
+            return ActionStatus::AlreadySanctioned;
+        if (state->coins < victim->traits().sanction_cost)
+            return ActionStatus::NotEnoughCoins;
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Sanctions a player if the rules allow it.
+     *
+     * A sanctioned Baron gets 1 coin back, only once the sanction is known to succeed.
+     *
+     * @param target Id of the player to sanction.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_sanction(PlayerId target)
+    {
+        ActionStatus status = check_sanction(target);
+        if (status != ActionStatus::Ok)
+            return status;
+        Player *victim = player_at(target);
+        const RoleTraits &target_traits = victim->traits();
+        set_coins(state->coins - target_traits.sanction_cost); // Judge costs 4, others cost 3
+        victim->set_coins(victim->state->coins + target_traits.sanction_refund); // Baron gets 1 coin back
+        victim->mark_sanctioned(id);                           // Apply sanction
+        game.emit(EventType::Sanction, id, target, target_traits.sanction_cost);
         game.next_turn();
+        return ActionStatus::Ok;
     }
 
     /**
@@ -164,29 +293,183 @@ namespace coup
      */
     void Player::coup(const std::shared_ptr<Player> &target)
     {
-        check_turn();
-        if (coins < 7)
-            throw NotEnoughCoinsException(7, coins);
-        if (target->is_eliminated())
-            throw TargetIsAlreadyEliminatedException();
-        if (target->get_name() == name)
-            throw CannotTargetYourselfException();
-        game.remove_player(target->get_name());     // Eliminate player
-        game.add_to_coup(name, target->get_name()); // Log coup
-        coins -= 7;                                 // Pay for coup
-        std::cout << name << " preformed coup on " << target->get_name() << "! \n"
-                  << std::endl;
+        ActionStatus status = try_coup(target->id);
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Coup, target.get());
+    }
+
+    /**
+     * @brief Checks whether a coup on a player is allowed right now.
+     * @param target Id of the player to eliminate.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Player::check_coup(PlayerId target) const
+    {
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            return status;
+        if (state->coins < kCoupCost)
+            return ActionStatus::NotEnoughCoins;
+        const Player *victim = player_at(target);
+        if (victim == nullptr)
+            return ActionStatus::InvalidTarget;
+        if (victim->is_eliminated())
+            return ActionStatus::TargetAlreadyEliminated;
+        if (target == id)
+            return ActionStatus::CannotTargetYourself;
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Eliminates a player if the rules allow it.
+     * @param target Id of the player to eliminate.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Player::try_coup(PlayerId target)
+    {
+        ActionStatus status = check_coup(target);
+        if (status != ActionStatus::Ok)
+            return status;
+        game.remove_player(target);  // Eliminate player
+        game.add_to_coup(id, target); // Log coup
+        set_coins(state->coins - kCoupCost); // Pay for coup
+        game.emit(EventType::Coup, id, target, kCoupCost);
         game.next_turn();
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Checks whether it's this player's turn, without throwing.
+     * @return ActionStatus Ok, GameNotStarted if no players are in the game, or NotYourTurn.
+     */
+    ActionStatus Player::turn_status() const
+    {
+        if (game.get_all_players().empty())
+            return ActionStatus::GameNotStarted;
+        if (game.get_turn_index() != id)
+            return ActionStatus::NotYourTurn;
+        return ActionStatus::Ok;
     }
 
     /**
      * @brief Verifies that it's this player's turn.
+     * @throws GameNotStartedException if no players are in the game.
      * @throws NotYourTurnException if it's not their turn.
      */
     void Player::check_turn() const
     {
-        if (game.turn() != name)
+        ActionStatus status = turn_status();
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Gather);
+    }
+
+    /**
+     * @brief Looks up a player of this player's game by id.
+     * @param player The id to look up.
+     * @return Player* The player, or nullptr if the id is not in the game.
+     */
+    Player *Player::player_at(PlayerId player) const
+    {
+        const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+        return player < players.size() ? players[player].get() : nullptr;
+    }
+
+    /**
+     * @brief Throws the exception that matches a refused action.
+     * @param status Why the action was refused (not Ok).
+     * @param kind The refused action, used for coin requirements and messages.
+     * @param target The action's target, if any.
+     */
+    void Player::raise(ActionStatus status, ActionKind kind, const Player *target) const
+    {
+        const char *ability = "";
+        const char *undone = "";
+        int required = 0;
+        switch (kind)
+        {
+        case ActionKind::Bribe:
+            required = kBribeCost;
+            break;
+        case ActionKind::Invest:
+            required = kInvestCost;
+            break;
+        case ActionKind::Coup:
+            required = kCoupCost;
+            break;
+        case ActionKind::Sanction:
+            required = target ? target->traits().sanction_cost : 0;
+            break;
+        case ActionKind::UndoTax:
+            ability = "UNDO TAX";
+            undone = "tax";
+            break;
+        case ActionKind::UndoBribe:
+            ability = "UNDO BRIBE";
+            undone = "bribe";
+            break;
+        case ActionKind::UndoCoup:
+            ability = "UNDO COUP";
+            required = kUndoCoupCost;
+            break;
+        case ActionKind::PeekAndDisable:
+            ability = "peek and disable";
+            break;
+        default:
+            break;
+        }
+        const std::string target_name = target ? target->name : "";
+
+        switch (status)
+        {
+        case ActionStatus::GameNotStarted:
+            throw GameNotStartedException();
+        case ActionStatus::NotYourTurn:
             throw NotYourTurnException();
+        case ActionStatus::MustCoup:
+            throw MustPerformCoupException();
+        case ActionStatus::Sanctioned:
+            throw SanctionedException();
+        case ActionStatus::NotEnoughCoins:
+            if (kind == ActionKind::UndoTax && target) // The taxed player can no longer pay it back
+                throw NotEnoughCoinsException(target->traits().tax_amount, target->get_coins());
+            throw NotEnoughCoinsException(required, state->coins);
+        case ActionStatus::ArrestBlocked:
+            throw ArrestBlockedException();
+        case ActionStatus::InvalidTarget:
+            throw PlayerNotFoundException(target_name);
+        case ActionStatus::CannotTargetYourself:
+            throw CannotTargetYourselfException();
+        case ActionStatus::TargetEliminated:
+            throw TargetIsEliminatedException();
+        case ActionStatus::TargetAlreadyEliminated:
+            throw TargetIsAlreadyEliminatedException();
+        case ActionStatus::TargetNotEliminated:
+            throw TargetNotEliminatedException();
+        case ActionStatus::DuplicateArrest:
+            throw DuplicateArrestException();
+        case ActionStatus::TargetNoCoins:
+            throw TargetNoCoinsException();
+        case ActionStatus::AlreadySanctioned:
+            throw AlreadySanctionedException();
+        case ActionStatus::PlayerEliminated:
+            throw PlayerEliminatedException(name);
+        case ActionStatus::AbilityUsed:
+            throw ActionAlreadyUsedThisRoundException(name, ability);
+        case ActionStatus::NotUndoable:
+            throw UndoNotAllowedException(target_name, std::string(" ") + undone);
+        case ActionStatus::CannotUndoOwnAction:
+            throw CannotUndoOwnActionException(name, undone);
+        case ActionStatus::ActionTooOld:
+            throw ActionTooOldException(target_name, undone);
+        case ActionStatus::NoRecentAction:
+            throw NoRecentActionToUndoException(undone);
+        case ActionStatus::NoCoupToUndo:
+            throw NoCoupToUndoException(target_name);
+        case ActionStatus::InvalidBribeUndo:
+            throw InvalidBribeUndoException();
+        default:
+            throw GameException(status_name(status));
+        }
     }
 
     /**
@@ -197,7 +480,21 @@ namespace coup
     {
         if (!is_eliminated())
             throw TargetNotEliminatedException();
-        eliminated = false;
+        set_flag(PlayerFlag::Eliminated, false);
+        if (id != kNoPlayer)
+            game.set_alive(id, true);
+    }
+
+    /**
+     * @brief Marks the player as eliminated (does nothing if already eliminated).
+     */
+    void Player::mark_eliminated()
+    {
+        if (is_eliminated())
+            return;
+        set_flag(PlayerFlag::Eliminated, true);
+        if (id != kNoPlayer)
+            game.set_alive(id, false);
     }
 
     /**
@@ -207,11 +504,11 @@ namespace coup
      */
     void Player::decrease_coins(int amount)
     {
-        if (coins < amount)
+        if (state->coins < amount)
         {
-            throw NotEnoughCoinsException(amount, coins);
+            throw NotEnoughCoinsException(amount, state->coins);
         }
-        coins -= amount;
+        set_coins(state->coins - amount);
     }
 
     /**
@@ -220,17 +517,34 @@ namespace coup
      */
     void Player::increase_coins(int amount)
     {
-        coins += amount;
+        set_coins(state->coins + amount);
     }
 
     /**
      * @brief Marks the player as sanctioned by another player.
-     * @param by_whom Name of the player who sanctioned.
+     * @param by_whom Name of the player who sanctioned (unknown names leave no owner).
      */
     void Player::mark_sanctioned(const std::string &by_whom)
     {
-        sanctioned = true;
-        sanctioned_by = by_whom;
+        mark_sanctioned(game.find_player_id(by_whom));
+    }
+
+    /**
+     * @brief Marks the player as sanctioned by another player.
+     * @param by_whom Id of the player who sanctioned.
+     */
+    void Player::mark_sanctioned(PlayerId by_whom)
+    {
+        clear_sanctioned(); // A player is sanctioned by one player at a time
+        set_flag(PlayerFlag::Sanctioned, true);
+        game.rehash(HashFeature::SanctionedBy, id, state->sanctioned_by, by_whom);
+        game.touch(state->sanctioned_by);
+        state->sanctioned_by = by_whom;
+        if (id != kNoPlayer && by_whom < kMaxPlayers)
+        {
+            game.touch(game.state.players[by_whom].sanctions_by);
+            game.state.players[by_whom].sanctions_by |= player_bit(id); // Reverse index for start_new_turn
+        }
     }
 
     /**
@@ -238,8 +552,15 @@ namespace coup
      */
     void Player::clear_sanctioned()
     {
-        sanctioned = false;
-        sanctioned_by.clear(); // Reset source of sanction
+        if (id != kNoPlayer && state->sanctioned_by < kMaxPlayers)
+        {
+            game.touch(game.state.players[state->sanctioned_by].sanctions_by);
+            game.state.players[state->sanctioned_by].sanctions_by &= ~player_bit(id);
+        }
+        set_flag(PlayerFlag::Sanctioned, false);
+        game.rehash(HashFeature::SanctionedBy, id, state->sanctioned_by, kNoPlayer);
+        game.touch(state->sanctioned_by);
+        state->sanctioned_by = kNoPlayer; // Reset source of sanction
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,62 @@
+// Author: noapatito123@gmail.com
+#include "Zobrist.hpp"
+
+namespace coup
+{
+
+    /**
+     * @brief Tells whether the latest tax can still be undone by age, using the
+     *        same rule as Governor::check_undo_tax.
+     * @param state The game state.
+     * @return true if a tax is pending and fewer than one lap of turns passed since.
+     */
+    bool tax_window_open(const GameState &state)
+    {
+        if (state.latest_tax == kNoPlayer)
+            return false;
+        int age = static_cast<int>(state.global_turn_index) - static_cast<int>(state.players[state.latest_tax].last_tax.turn);
+        return age <= mask_count(state.alive) - 1;
+    }
+
+    /**
+     * @brief Computes the hash contribution of one player from scratch.
+     * @param state The game state.
+     * @param player The player to hash.
+     * @return std::uint64_t XOR of the keys of every per-player feature.
+     */
+    std::uint64_t hash_player(const GameState &state, PlayerId player)
+    {
+        const PlayerState &p = state.players[player];
+        return zobrist_key(HashFeature::Role, player, static_cast<std::int32_t>(p.role)) ^
+               zobrist_key(HashFeature::Coins, player, p.coins) ^
+               zobrist_key(HashFeature::Flags, player, p.flags) ^
+               zobrist_key(HashFeature::ExtraTurns, player, p.extra_turns) ^
+               zobrist_key(HashFeature::ArrestTurns, player, p.disable_arrest_turns) ^
+               zobrist_key(HashFeature::SanctionedBy, player, p.sanctioned_by) ^
+               zobrist_key(HashFeature::CoupedBy, player, state.players[player].couped_by) ^
+               zobrist_key(HashFeature::Tax, player, tax_hash_value(state.players[player].last_tax));
+    }
+
+    /**
+     * @brief Computes the hash of a whole state from scratch.
+     *
+     * The game keeps GameState::hash equal to this value by updating it inside
+     * every action; this function is the reference it can be checked against.
+     * Round and turn counters are left out so that the same position reached at
+     * different times hashes the same.
+     *
+     * @param state The game state.
+     * @return std::uint64_t The position hash.
+     */
+    std::uint64_t hash_state(const GameState &state)
+    {
+        std::uint64_t hash = zobrist_key(HashFeature::TurnIndex, 0, state.turn_index) ^
+                             zobrist_key(HashFeature::LastArrested, 0, state.last_arrested) ^
+                             zobrist_key(HashFeature::LatestTax, 0, state.latest_tax) ^
+                             zobrist_key(HashFeature::TaxWindow, 0, state.tax_window);
+        for (PlayerId player = 0; player < state.player_count; ++player)
+            hash ^= hash_player(state, player);
+        return hash;
+    }
+
+}
@@ -8,7 +8,6 @@ namespace coup
         const char *NotYourTurn = "Not your turn.";
         const std::string Sanctioned = "You are sanctioned and cannot perform this action.";
         const std::string AlreadySanctioned = "Target is already sanctioned.";
-        const std::string MaxPlayersExceeded = "Cannot add more than 6 players.";
         const std::string DuplicateArrest = "Cannot arrest the same player twice in a row.";
         const std::string MustPerformCoup = "You must perform a COUP when you have 10 or more coins.";
         const std::string TargetNoCoins = "Target has no coins to arrest.";
@@ -22,6 +21,9 @@ namespace coup
         const std::string InvalidBribeUndo = "Target has not done a bribe or has already undone it.";
         const std::string CannotTargetYourself = "You cannot target yourself.";
         const std::string ArrestBlocked = "You are blocked from using ARREST this turn.";
+        const std::string StateMismatch = "Game state does not match the players in this game.";
+        const std::string ReplayFormat = "Replay data is truncated or malformed.";
+        const std::string SnapshotFormat = "Snapshot is truncated, corrupt or from an unknown version.";
 
         // Dynamic messages
         std::string NotEnoughCoins(int required, int curr)
@@ -64,5 +66,18 @@ namespace coup
         {
             return "No coup was found to undo for " + target + ".";
         }
+        std::string ReplayMismatch(std::uint64_t record, const std::string &what)
+        {
+            return "Replay diverged at record " + std::to_string(record) + ": " + what;
+        }
+        std::string MaxPlayersExceeded(std::size_t limit)
+        {
+            return "Cannot add more than " + std::to_string(limit) + " players.";
+        }
+        std::string InvalidTableSize(std::size_t requested, std::size_t seated, std::size_t capacity)
+        {
+            return "Invalid table size " + std::to_string(requested) + ": it must be at least 1, hold the " +
+                   std::to_string(seated) + " seated players and be at most " + std::to_string(capacity) + ".";
+        }
     }
 }
\ No newline at end of file
@@ -26,10 +26,12 @@ using namespace sf;
  * - Dark red for sanctioned players
  * - Red for players who were last arrested
  * - Yellow for players who are both sanctioned and last arrested
+ *
+ * Six players fit in a column; larger tables continue in columns to the left.
  */
 void GameGUI::drawPlayerList()
 {
-    float startY = 500; // Starting Y-coordinate for the first player's label
+    int row = 0; // Position of the player's label in the list
     for (const std::shared_ptr<Player>& player : game.get_all_players()) // Iterate over all players in the game
     {
         sf::Text info;
@@ -64,8 +66,8 @@ void GameGUI::drawPlayerList()
         }
 
         info.setString(label); // Set the player's label as the text content
-        info.setPosition(700, startY); // Position the text on the screen
+        info.setPosition(700 - 260 * (row / 6), 500 + 25 * (row % 6)); // Position the text on the screen
         window.draw(info); // Draw the text to the window
-        startY += 25; // Move down for the next player entry
+        row++; // Move on to the next player entry
     }
 }
\ No newline at end of file
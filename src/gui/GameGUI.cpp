@@ -8,26 +8,45 @@
 #include "General.hpp"
 #include "Judge.hpp"
 #include "Merchant.hpp"
+#include "RoleFactory.hpp"
+#include "SimEngine.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
-#include <ctime>
+#include <chrono>
+#include <random>
+#include <thread>
 
 using namespace coup;
 using namespace sf;
+
+namespace
+{
+    // Bots think for a fixed time per move on every core
+    MctsConfig botConfig()
+    {
+        MctsConfig config;
+        config.playouts = 0;
+        config.seconds = 0.3;
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+        return config;
+    }
+}
+
 /**
  * @brief Constructs the main GameGUI window and initializes the setup screen.
  *
  * Loads the font, creates input fields and buttons for adding players and starting the game.
  * Also sets their associated callback actions, including validation and role assignment.
  */
-GameGUI::GameGUI() : window(VideoMode(1000, 700), "Coup Interactive GUI")
+GameGUI::GameGUI() : window(VideoMode(1000, 700), "Coup Interactive GUI"), consoleLog(game, std::cout, 0),
+                     bot(botConfig()), botRng(std::random_device()()), roleRng(std::random_device()())
 {
+    game.set_event_sink(&consoleLog); // Log every action to the console
     if (!font.loadFromFile("arial.ttf"))
     {
         throw std::runtime_error("Failed to load font");
     }
-    srand(time(nullptr)); // Initialize random seed for role assignment
 
     // Create name input box
     nameBox = new TextBox(font, {300, 30}, {50, 50});
@@ -37,29 +56,20 @@ GameGUI::GameGUI() : window(VideoMode(1000, 700), "Coup Interactive GUI")
     addPlayerBtn = new Button("Add Player", font, {150, 40}, {370, 50});
     addPlayerBtn->setAction([this]()
                             {
-        std::string name = nameBox->getText();
-        if (name.empty()) {
+        if (nameBox->getText().empty()) {
             setupError = "Name cannot be empty";
             return;
         }
+        addSetupPlayer(nameBox->getText(), false); });
 
-        // Prevent duplicate names
-        if (std::find(tempNames.begin(), tempNames.end(), name) != tempNames.end()) {
-            setupError = "Name already exists. Please choose a different one.";
-            nameBox->clear();
-            nameBox->setSelected(true);
-            return;
-        }
-        
-        // Limit to 6 players
-        if (tempNames.size() >= 6) {
-            setupError = "Cannot add more than 6 players";
-            return;
-        }
-        tempNames.push_back(name);
-        tempRoles.push_back(randomRole());
-        nameBox->clear();
-        setupError.clear(); });
+    // Create "Add Bot" button: a computer player (named after the box, or numbered)
+    addBotBtn = new Button("Add Bot", font, {120, 40}, {530, 50});
+    addBotBtn->setAction([this]()
+                         {
+        std::string name = nameBox->getText();
+        if (name.empty())
+            name = "Bot " + std::to_string(tempNames.size() + 1);
+        addSetupPlayer(name, true); });
 
     // Create "Start Game" button and assign role-based players
     startGameBtn = new Button("Start Game", font, {150, 40}, {50, 100});
@@ -70,14 +80,9 @@ GameGUI::GameGUI() : window(VideoMode(1000, 700), "Coup Interactive GUI")
             return;
         }
         for (size_t i = 0; i < tempNames.size(); ++i) {
-            const std::string& role = tempRoles[i];
-            if (role == "Governor") game.add_player(std::make_shared<Governor>(game, tempNames[i]));
-            else if (role == "Spy") game.add_player(std::make_shared<Spy>(game, tempNames[i]));
-            else if (role == "Baron") game.add_player(std::make_shared<Baron>(game, tempNames[i]));
-            else if (role == "General") game.add_player(std::make_shared<General>(game, tempNames[i]));
-            else if (role == "Judge") game.add_player(std::make_shared<Judge>(game, tempNames[i]));
-            else if (role == "Merchant") game.add_player(std::make_shared<Merchant>(game, tempNames[i]));
+            game.add_player(create_player(game, tempRoles[i], tempNames[i]));
         }
+        botSeats = tempBots;
 
         setupButtons();
         state = GUIState::InGame; });
@@ -92,7 +97,33 @@ GameGUI::GameGUI() : window(VideoMode(1000, 700), "Coup Interactive GUI")
             }
             tempNames = {"Alice", "Bob", "Carol", "Dave", "Eve", "Frank"};
             tempRoles = {"Spy", "Governor", "General", "Judge", "Baron", "Merchant"};
+            tempBots.assign(tempNames.size(), false);
+            if (game.get_max_players() < tempNames.size())
+                game.set_max_players(tempNames.size()); // Make room for the demo players
             setupError.clear(); });
+
+    // Create "-" and "+" buttons to choose the table size (shown as "Seats: N" between them)
+    fewerSeatsBtn = new Button("-", font, {40, 40}, {400, 100});
+    fewerSeatsBtn->setAction([this]()
+                             {
+        std::size_t seats = game.get_max_players();
+        if (seats <= std::max<std::size_t>(2, tempNames.size())) {
+            setupError = "The table cannot be smaller than its players";
+            return;
+        }
+        game.set_max_players(seats - 1);
+        setupError.clear(); });
+
+    moreSeatsBtn = new Button("+", font, {40, 40}, {560, 100});
+    moreSeatsBtn->setAction([this]()
+                            {
+        std::size_t seats = game.get_max_players();
+        if (seats >= kMaxSeats) {
+            setupError = "The window fits at most " + std::to_string(kMaxSeats) + " seats";
+            return;
+        }
+        game.set_max_players(seats + 1);
+        setupError.clear(); });
 }
 
 /**
@@ -124,9 +155,15 @@ void GameGUI::run()
                         startGameBtn->execute();
                     if (demoGameBtn->contains(x, y))
                         demoGameBtn->execute();
+                    if (addBotBtn->contains(x, y))
+                        addBotBtn->execute();
+                    if (fewerSeatsBtn->contains(x, y))
+                        fewerSeatsBtn->execute();
+                    if (moreSeatsBtn->contains(x, y))
+                        moreSeatsBtn->execute();
                     nameBox->setSelected(nameBox->getText().empty());
                 }
-                else if (state == GUIState::InGame && !showVictory)
+                else if (state == GUIState::InGame && !showVictory && !botMove.valid()) // The table waits while a bot thinks
                 {
                     for (Button &btn : buttons)
                     {
@@ -158,6 +195,8 @@ void GameGUI::run()
                                 btn.execute();
                                 state = GUIState::InGame;
                                 targetButtons.clear();
+                                buttons.clear(); // Rebuild buttons after action
+                                setupButtons();  // Refresh available actions
                             }
                             catch (const GameException &e)
                             {
@@ -189,32 +228,37 @@ void GameGUI::run()
             }
         }
 
+        if (state == GUIState::InGame && !showVictory && !game.is_game_over())
+            playBotTurn(); // The search runs on its own thread, so the table is redrawn meanwhile
+
         window.clear(Color(50, 50, 50)); // Background color
 
-        // Check for winner if no one has won yet
-        if (!showVictory)
+        // Check for winner if no one has won yet (cached by the game, no exceptions)
+        if (!showVictory && game.is_game_over())
         {
-            try
-            {
-                std::string winner = game.winner();
-                winnerMessage = " The winner is: " + winner + "!";
-                showVictory = true;
-            }
-            catch (...)
-            {
-                showVictory = false;
-                winnerMessage.clear();
-            }
+            winnerMessage = " The winner is: " + game.get_all_players()[game.get_winner()]->get_name() + "!";
+            showVictory = true;
         }
 
         if (state == GUIState::Setup)
         {
             nameBox->draw(window);
             addPlayerBtn->draw(window);
+            addBotBtn->draw(window);
             demoGameBtn->draw(window);
+            fewerSeatsBtn->draw(window);
+            moreSeatsBtn->draw(window);
             if (tempNames.size() >= 2)
                 startGameBtn->draw(window);
 
+            Text seats;
+            seats.setFont(font);
+            seats.setCharacterSize(18);
+            seats.setFillColor(Color::White);
+            seats.setString("Seats: " + std::to_string(game.get_max_players()));
+            seats.setPosition(450, 108);
+            window.draw(seats);
+
             float y = 160;
             for (size_t i = 0; i < tempNames.size(); ++i)
             {
@@ -222,7 +266,7 @@ void GameGUI::run()
                 t.setFont(font);
                 t.setCharacterSize(18);
                 t.setFillColor(Color::White);
-                t.setString(tempNames[i] + " - " + tempRoles[i]);
+                t.setString(tempNames[i] + " - " + tempRoles[i] + (tempBots[i] ? " (bot)" : ""));
                 t.setPosition(50, y);
                 window.draw(t);
                 y += 30;
@@ -252,6 +296,17 @@ void GameGUI::run()
             header.setPosition(300, 20);
             window.draw(header);
 
+            if (botMove.valid())
+            {
+                sf::Text thinking;
+                thinking.setFont(font);
+                thinking.setCharacterSize(18);
+                thinking.setFillColor(sf::Color::White);
+                thinking.setString(current->get_name() + " (bot) is thinking...");
+                thinking.setPosition(300, 55);
+                window.draw(thinking);
+            }
+
             if (!actionMessage.empty())
             {
                 sf::Text msgText;
@@ -323,5 +378,82 @@ void GameGUI::run()
 std::string GameGUI::randomRole()
 {
     std::vector<std::string> roles = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
-    return roles[rand() % roles.size()];
+    return roles[roleRng() % roles.size()];
+}
+
+/**
+ * @brief Validates a new player on the setup screen and queues it with a random role.
+ *
+ * @param name The player's name.
+ * @param isBot true if the computer plays this seat.
+ * @return true if the player was added, false if setupError explains why not.
+ */
+bool GameGUI::addSetupPlayer(const std::string &name, bool isBot)
+{
+    // Prevent duplicate names
+    if (std::find(tempNames.begin(), tempNames.end(), name) != tempNames.end())
+    {
+        setupError = "Name already exists. Please choose a different one.";
+        nameBox->clear();
+        nameBox->setSelected(true);
+        return false;
+    }
+
+    // Limit to the table size of the game
+    if (tempNames.size() >= game.get_max_players())
+    {
+        setupError = "Cannot add more than " + std::to_string(game.get_max_players()) + " players";
+        return false;
+    }
+    tempNames.push_back(name);
+    tempRoles.push_back(randomRole());
+    tempBots.push_back(isBot);
+    nameBox->clear();
+    setupError.clear();
+    return true;
+}
+
+/**
+ * @brief Plays one move for the current player if a bot controls that seat.
+ *
+ * The move is chosen by MCTS on a copy of the game, on a thread of its own, so
+ * the window keeps drawing while the bot thinks. The first call starts the
+ * search; later calls (one per frame) return at once until it is done, and then
+ * play the move. If the rules refuse it the bot gathers, and if even that is
+ * impossible it passes.
+ */
+void GameGUI::playBotTurn()
+{
+    PlayerId current = static_cast<PlayerId>(game.get_turn_index());
+    if (current >= botSeats.size() || !botSeats[current])
+        return;
+
+    if (!botMove.valid())
+    {
+        botGame = mirror_game(game);
+        botMove = std::async(std::launch::async, [this, current]()
+                             { return bot.choose_action(*botGame, current, botRng); });
+        return;
+    }
+    if (botMove.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return; // Still thinking
+
+    Action move = botMove.get();
+    if (!SimEngine::apply(game, move))
+    {
+        move = Action{ActionKind::Gather, current, kNoTarget};
+        if (!SimEngine::apply(game, move))
+        {
+            game.pass_turn();
+            return;
+        }
+    }
+
+    const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+    actionMessage = players[current]->get_name() + " (bot) played " + action_name(move.kind);
+    if (move.target < players.size())
+        actionMessage += " on " + players[move.target]->get_name();
+    inGameError.clear();
+    buttons.clear(); // Rebuild buttons after action
+    setupButtons();  // Refresh available actions
 }
@@ -22,15 +22,18 @@ using namespace sf;
  *
  * Each button is labeled with the action and the player's name, and invokes a given action.
  * The function automatically filters out eliminated players, and supports error handling.
+ * Buttons of players who cannot use the ability right now are greyed out.
  *
  * @param role The role name to match (e.g., "Judge", "Spy").
  * @param buttonPrefix Prefix to display on each button (e.g., "Undo Coup").
+ * @param ability The ability the buttons trigger, used to check whether it is legal.
  * @param startY The starting Y-position for placing buttons.
  * @param actionPerPlayer The function to call when a button is clicked.
  * @return int The number of buttons added.
  */
 int GameGUI::addRoleActionButtons(const std::string &role,
                                   const std::string &buttonPrefix,
+                                  ActionKind ability,
                                   float startY,
                                   std::function<void(const std::shared_ptr<Player> &)> actionPerPlayer)
 {
@@ -59,6 +62,7 @@ int GameGUI::addRoleActionButtons(const std::string &role,
 
         std::string label = buttonPrefix + " (" + p->get_name() + ")";
         Button btn(label, font, sf::Vector2f(190, 35), sf::Vector2f(800, y));
+        btn.setEnabled(game.legal_actions(p->get_id()).any(ability));
         y += 40;
         count++;
 
@@ -67,15 +71,9 @@ int GameGUI::addRoleActionButtons(const std::string &role,
                       {
             try {
                 if (p->is_eliminated()) {
-                    bool was_couped = false;
-                    for (const auto& pair : game.get_coup_list()) {
-                        if (pair.second == p->get_name()) {
-                            was_couped = true;
-                            break;
-                        }
-                    }
+                    bool was_couped = game.is_in_coup_list(p->get_id());
 
-                    if (p->role() != "General" || !was_couped) {
+                    if (p->role_id() != RoleId::General || !was_couped) {
                         inGameError = p->get_name() + " is eliminated.";
                         return;
                     }
@@ -105,6 +103,7 @@ void GameGUI::setupButtons()
 {
     std::shared_ptr<Player> &p = game.get_current_player();
     std::string role = p->role();
+    const ActionSet legal = game.legal_actions(); // Grey out what the current player cannot do
 
     // Player action: Gather
     Button gatherBtn("Gather", font, sf::Vector2f(150, 40), sf::Vector2f(50, 100));
@@ -114,6 +113,7 @@ void GameGUI::setupButtons()
         p->gather();
         actionMessage = p->get_name() + " performed Gather. Coins: " + std::to_string(p->get_coins());
         inGameError.clear(); });
+    gatherBtn.setEnabled(legal.allows(ActionKind::Gather));
     buttons.push_back(gatherBtn);
 
     // Player action: Tax
@@ -124,6 +124,7 @@ void GameGUI::setupButtons()
         p->tax();
         actionMessage = p->get_name() + " performed Tax. Coins: " + std::to_string(p->get_coins());
         inGameError.clear(); });
+    taxBtn.setEnabled(legal.allows(ActionKind::Tax));
     buttons.push_back(taxBtn);
 
     // Player action: Bribe
@@ -134,6 +135,7 @@ void GameGUI::setupButtons()
         p->bribe();
         actionMessage = p->get_name() + " performed Bribe. Coins: " + std::to_string(p->get_coins());
         inGameError.clear(); });
+    bribeBtn.setEnabled(legal.allows(ActionKind::Bribe));
     buttons.push_back(bribeBtn);
 
     // Player action: Arrest
@@ -141,9 +143,10 @@ void GameGUI::setupButtons()
     arrestBtn.setAction([this]()
                         {
     std::vector<std::shared_ptr<Player>> activePlayers;
+    const ActionSet legal = game.legal_actions();
     for (const auto &p : game.get_all_players())
     {
-        if (!p->is_eliminated() && p != game.get_current_player())
+        if (legal.allows(ActionKind::Arrest, p->get_id()))
         {
             activePlayers.push_back(p);
         }
@@ -167,6 +170,7 @@ void GameGUI::setupButtons()
             actionMessage.clear();
         } }, activePlayers); });
 
+    arrestBtn.setEnabled(legal.any(ActionKind::Arrest));
     buttons.push_back(arrestBtn);
 
     // Player action: Sanction
@@ -174,9 +178,10 @@ void GameGUI::setupButtons()
     sanctionBtn.setAction([this]()
                           {
         std::vector<std::shared_ptr<Player>> activePlayers;
+        const ActionSet legal = game.legal_actions();
         for (const auto &p : game.get_all_players())
         {
-            if (!p->is_eliminated() && p != game.get_current_player())
+            if (legal.allows(ActionKind::Sanction, p->get_id()))
             {
                 activePlayers.push_back(p);
             }
@@ -196,6 +201,7 @@ void GameGUI::setupButtons()
         } catch (const std::exception& e) {
             inGameError = e.what();     // Catch the error from arrest
             actionMessage.clear(); }}, activePlayers); });
+    sanctionBtn.setEnabled(legal.any(ActionKind::Sanction));
     buttons.push_back(sanctionBtn);
 
     // Player action: Coup
@@ -203,9 +209,10 @@ void GameGUI::setupButtons()
     coupBtn.setAction([this]()
                       {
     std::vector<std::shared_ptr<Player>> aliveTargets;
+    const ActionSet legal = game.legal_actions();
     for (const auto &p : game.get_all_players())
     {
-        if (!p->is_eliminated() && p != game.get_current_player())
+        if (legal.allows(ActionKind::Coup, p->get_id()))
         {
             aliveTargets.push_back(p);
         }
@@ -231,6 +238,7 @@ void GameGUI::setupButtons()
             }
         },
         aliveTargets); });
+    coupBtn.setEnabled(legal.any(ActionKind::Coup));
     buttons.push_back(coupBtn);
 
     // Role-specific action: invest for Baron
@@ -244,6 +252,7 @@ void GameGUI::setupButtons()
             static_cast<Baron*>(p.get())->invest();
             actionMessage = p->get_name() + " Invested " + "! " + p->get_name() + " has " + std::to_string(p->get_coins()) + " coins.";
             inGameError.clear(); });
+        investBtn.setEnabled(legal.allows(ActionKind::Invest));
         buttons.push_back(investBtn);
     }
 
@@ -251,7 +260,7 @@ void GameGUI::setupButtons()
     float y = 50;
 
     // Governor: Undo Tax
-    y += 40 * addRoleActionButtons("Governor", "Undo Tax", y, [this](const std::shared_ptr<Player> &p)
+    y += 40 * addRoleActionButtons("Governor", "Undo Tax", ActionKind::UndoTax, y, [this](const std::shared_ptr<Player> &p)
                                    {
     try {
         std::string msg = static_cast<Governor*>(p.get())->undo_tax();  
@@ -263,7 +272,7 @@ void GameGUI::setupButtons()
     } });
 
     // Judge: Undo Bribe
-    y += 40 * addRoleActionButtons("Judge", "Undo Bribe", y, [this](const std::shared_ptr<Player> &p)
+    y += 40 * addRoleActionButtons("Judge", "Undo Bribe", ActionKind::UndoBribe, y, [this](const std::shared_ptr<Player> &p)
                                    {
     try {
         std::shared_ptr<Player> current = game.get_current_player();
@@ -276,7 +285,7 @@ void GameGUI::setupButtons()
     } });
 
     // Spy: Peek and Disable
-    y += 40 * addRoleActionButtons("Spy", "Peek and Disable", y, [this](const std::shared_ptr<Player> &p)
+    y += 40 * addRoleActionButtons("Spy", "Peek and Disable", ActionKind::PeekAndDisable, y, [this](const std::shared_ptr<Player> &p)
                                    {
     // Filtering targets: only living players and not the player themselves
     std::vector<std::shared_ptr<Player>> filteredTargets;
@@ -312,16 +321,13 @@ void GameGUI::setupButtons()
         true); });
 
     // General: Undo Coup
-    y += 40 * addRoleActionButtons("General", "Undo Coup", y, [this](const std::shared_ptr<Player> &p)
+    y += 40 * addRoleActionButtons("General", "Undo Coup", ActionKind::UndoCoup, y, [this](const std::shared_ptr<Player> &p)
                                    {
     // Get the list of victims from the game itself
     std::vector<std::shared_ptr<Player>> targets;
-    for (const auto& entry : game.get_coup_list()) {
-        try {
-            std::shared_ptr<Player>& target = game.get_player(entry.second);
-            if(!target->is_eliminated()) continue;
+    for (const auto& target : game.get_all_players()) {
+        if (target->is_eliminated() && game.is_in_coup_list(target->get_id()))
             targets.push_back(target);
-        } catch (...) {}
     }
 
     showTargetSelection(
@@ -340,13 +346,18 @@ void GameGUI::setupButtons()
     Button newGameBtn("New Game", font, sf::Vector2f(150, 40), sf::Vector2f(800, 650));
     newGameBtn.setAction([this]()
                          {
-                             game = Game(); // Reset the game state
+                             game = Game(game.get_max_players()); // Reset the game state, keeping the table size
+                             game.set_event_sink(&consoleLog); // Keep logging actions of the new game
                              tempNames.clear(); // Clear temporary names
                              tempRoles.clear(); // Clear temporary roles
+                             tempBots.clear(); // Clear temporary bot flags
+                             botSeats.clear(); // No bots in the next game until added
                              buttons.clear(); // Clear buttons
                              actionMessage.clear(); // Clear action messages
                              setupError.clear(); // Clear setup error if exists
                              inGameError.clear(); // Clear error messages
+                             showVictory = false; // Leave the victory screen
+                             winnerMessage.clear(); // Forget the previous winner
                              targetButtons.clear(); // Clear target buttons if they exist
                              state = GUIState::Setup; // Return to setup screen
                          });
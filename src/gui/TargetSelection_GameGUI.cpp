@@ -23,6 +23,7 @@ using namespace sf;
  * If no targets are available, it returns to the game state with an error message.
  *
  * Each button corresponds to a valid target and triggers the provided action upon selection.
+ * Six buttons fit in a column; more targets continue in a second column.
  * Also includes a "Back" button to cancel the selection and return to the main game screen.
  *
  * @param action The function to call when a target is selected.
@@ -36,7 +37,6 @@ void GameGUI::showTargetSelection(std::function<void(const std::shared_ptr<Playe
     targetAction = action;
 
     std::shared_ptr<Player>& current = game.get_current_player();
-    float y = 150;
 
     std::vector<int> finalTargetsIdx;
 
@@ -61,9 +61,10 @@ void GameGUI::showTargetSelection(std::function<void(const std::shared_ptr<Playe
     }
 
     // Create a button for each valid target
+    int row = 0;
     for(int i : finalTargetsIdx) {
         const std::shared_ptr<Player>& p = targets[i];
-        Button btn(p->get_name(), font, {200, 40}, {400, y});
+        Button btn(p->get_name(), font, {200, 40}, {400.f + 220 * (row / 6), 150.f + 50 * (row % 6)});
         btn.setAction([this, p]()
                       {
             try {
@@ -77,7 +78,7 @@ void GameGUI::showTargetSelection(std::function<void(const std::shared_ptr<Playe
                 state = GUIState::InGame;
             } });
         targetButtons.push_back(btn);
-        y += 50;
+        row++;
     }
 
     // BACK button to return to game without choosing a target
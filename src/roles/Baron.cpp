@@ -2,7 +2,6 @@
 #include "Baron.hpp"
 #include "Game.hpp"
 #include "exceptions.hpp"
-#include <iostream>
 
 namespace coup
 {
@@ -12,7 +11,7 @@ namespace coup
      * @param game Reference to the game object.
      * @param name Name of the player.
      */
-    Baron::Baron(Game &game, const std::string &name) : Player(game, name) {}
+    Baron::Baron(Game &game, const std::string &name) : Player(game, name, RoleId::Baron) {}
     
     /**
      * @brief Destructor for the Baron class.
@@ -26,14 +25,40 @@ namespace coup
      */
     void Baron::invest()
     {
-        check_turn(); // Ensure it's Baron's turn
+        ActionStatus status = try_invest();
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::Invest);
+    }
+
+    /**
+     * @brief Checks whether invest is allowed right now.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Baron::check_invest() const
+    {
+        ActionStatus status = turn_status(); // Ensure it's Baron's turn
+        if (status != ActionStatus::Ok)
+            return status;
         if (must_coup())
-            throw MustPerformCoupException();
-        if (coins < 3)
-            throw NotEnoughCoinsException(3, coins);
-        coins += 3; // Gain 3 coins
-        std::cout << name << " preformed invest! \n" << std::endl;
+            return ActionStatus::MustCoup;
+        if (state->coins < kInvestCost)
+            return ActionStatus::NotEnoughCoins;
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Invests if the rules allow it.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Baron::try_invest()
+    {
+        ActionStatus status = check_invest();
+        if (status != ActionStatus::Ok)
+            return status;
+        set_coins(state->coins + kInvestCost); // Gain 3 coins
+        game.emit(EventType::Invest, get_id(), kNoPlayer, kInvestCost);
         game.next_turn(); // Advance to next player's turn
+        return ActionStatus::Ok;
     }
 
     /**
@@ -2,8 +2,6 @@
 #include "General.hpp"
 #include "Game.hpp"
 #include "exceptions.hpp"
-#include <algorithm>
-#include <iostream>
 
 namespace coup
 {
@@ -13,7 +11,7 @@ namespace coup
      * @param game Reference to the game object.
      * @param name Name of the player.
      */
-    General::General(Game &game, const std::string &name) : Player(game, name) {}
+    General::General(Game &game, const std::string &name) : Player(game, name, RoleId::General) {}
 
     /**
      * @brief Destructor for the General class.
@@ -35,42 +33,68 @@ namespace coup
      */
     std::string General::undo_coup(const std::shared_ptr<Player> &target)
     {
+        ActionStatus status = try_undo_coup(target->get_id());
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::UndoCoup, target.get());
 
+        return name + " undid coup on " + target->get_name();
+    }
+
+    /**
+     * @brief Checks whether undoing the coup on a player is allowed right now.
+     * @param target Id of the eliminated player to revive.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus General::check_undo_coup(PlayerId target) const
+    {
         if (!can_undo_coup())
         {
-            throw ActionAlreadyUsedThisRoundException(name, "UNDO COUP");
+            return ActionStatus::AbilityUsed;
+        }
+
+        if (state->coins < kUndoCoupCost)
+        {
+            return ActionStatus::NotEnoughCoins;
         }
 
-        if (coins < 5)
+        const Player *victim = player_at(target);
+        if (victim == nullptr)
         {
-            throw NotEnoughCoinsException(5, coins);
+            return ActionStatus::InvalidTarget;
         }
 
-        if (!target->is_eliminated())
+        if (!victim->is_eliminated())
         {
-            throw TargetNotEliminatedException();
+            return ActionStatus::TargetNotEliminated;
         }
 
         // Check if the target is in coup list
-        if (!game.is_in_coup_list(target->get_name()))
-            throw NoCoupToUndoException(target->get_name());
+        if (!game.is_in_coup_list(target))
+            return ActionStatus::NoCoupToUndo;
+
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Undoes the coup on a player if the rules allow it.
+     * @param target Id of the eliminated player to revive.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus General::try_undo_coup(PlayerId target)
+    {
+        ActionStatus status = check_undo_coup(target);
+        if (status != ActionStatus::Ok)
+            return status;
 
-        coins -= 5;       // Pay 5 coins
-        target->revive(); // Revive the eliminated player
+        Player *victim = player_at(target);
+        set_coins(state->coins - kUndoCoupCost); // Pay 5 coins
+        victim->revive(); // Revive the eliminated player
 
-        // Remove the coup record targeting the revived player
-        game.get_coup_list().erase(
-            std::remove_if(game.get_coup_list().begin(), game.get_coup_list().end(),
-                           [&target](const std::pair<std::string, std::string> &entry)
-                           {
-                               return entry.second == target->get_name(); // Match by target name
-                           }),
-            game.get_coup_list().end());
+        game.remove_from_coup_list(target); // Remove the coup record targeting the revived player
 
         mark_undo_coup_used(); // Mark ability as used this round
-        std::cout << name << " preformed undo-coup on " << target->get_name() << "! \n"
-                  << std::endl;
-        return name + " undid coup on " + target->get_name();
+        game.emit(EventType::UndoCoup, get_id(), target, kUndoCoupCost);
+        return ActionStatus::Ok;
     }
 
     /**
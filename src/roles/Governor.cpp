@@ -2,7 +2,6 @@
 #include "Governor.hpp"
 #include "exceptions.hpp"
 #include "Game.hpp"
-#include <iostream>
 
 namespace coup
 {
@@ -12,38 +11,17 @@ namespace coup
      * @param game Reference to the Game instance.
      * @param name Player's name.
      */
-    Governor::Governor(Game &game, const std::string &name) : Player(game, name) {}
+    Governor::Governor(Game &game, const std::string &name) : Player(game, name, RoleId::Governor) {}
 
     /**
      * @brief Destructor for the Governor class.
      */
     Governor::~Governor() = default;
 
-    /**
-     * @brief Performs the tax action (gain 3 coins and logs it).
-     * @throws MustPerformCoupException if player must coup.
-     * @throws SanctionedException if player is sanctioned.
-     */
-    void Governor::tax()
-    {
-        check_turn();
-        if (must_coup())
-            throw MustPerformCoupException();
-        if (is_sanctioned())
-            throw SanctionedException();
-
-        coins += 3;
-        game.get_action_history().emplace_back(name, "tax", game.get_current_round());
-        game.get_tax_turns()[name] = game.get_global_turn_index(); // update last round
-        std::cout << name << " preformed tax! \n"
-                  << std::endl;
-        game.next_turn();
-    }
-
     /**
      * @brief Cancels the most recent valid tax action by another player.
      *
-     * Decreases that player's coins and removes the action from history.
+     * Decreases that player's coins and marks their tax as undone.
      *
      * @return std::string Message describing the undo.
      *
@@ -55,59 +33,95 @@ namespace coup
      */
     std::string Governor::undo_tax()
     {
+        PlayerId taxed = kNoPlayer;
+        ActionStatus status = try_undo_tax(&taxed);
+        Player *target = player_at(taxed);
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::UndoTax, target);
+
+        int amount = game.get_last_tax(taxed).amount; // Governor taxed 3, others 2
+        return name + " canceled " + target->get_name() + "'s tax. " +
+               std::to_string(amount) + " coins were removed.";
+    }
+
+    /**
+     * @brief Checks whether undoing the most recent tax is allowed right now.
+     *
+     * Only the latest tax that has not been undone can be cancelled, so the
+     * check is a constant-time look at that player's last-tax record.
+     *
+     * @param taxed If not null, receives the id of the player whose tax was examined (kNoPlayer if none).
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Governor::check_undo_tax(PlayerId *taxed) const
+    {
+        if (taxed)
+            *taxed = kNoPlayer;
+
         if (is_eliminated())
         {
-            throw PlayerEliminatedException(name);
+            return ActionStatus::PlayerEliminated;
+        }
+
+        if (state->has(PlayerFlag::AbilityUsed))
+        {
+            return ActionStatus::AbilityUsed;
         }
 
-        if (used_undo_this_round)
+        PlayerId actor = game.get_latest_tax();
+        const Player *target = player_at(actor);
+        if (target == nullptr || !game.get_last_tax(actor).undoable)
         {
-            throw ActionAlreadyUsedThisRoundException(name, "UNDO TAX");
+            return ActionStatus::NoRecentAction; // No valid tax found
         }
+        if (taxed)
+            *taxed = actor;
 
-        auto &history = game.get_action_history();
+        const TaxRecord &tax = game.get_last_tax(actor);
         int global_turn = game.get_global_turn_index();
         int players_count = game.get_active_players_count();
+        if (target->is_eliminated())
+        {
+            return ActionStatus::TargetEliminated;
+        }
 
-        // Iterate in reverse to find the most recent tax
-        for (auto it = history.rbegin(); it != history.rend(); ++it)
+        if (actor == get_id())
         {
-            const std::string &actor = std::get<0>(*it);
-            const std::string &action = std::get<1>(*it);
-            int round = game.get_tax_turns()[actor];
-            // Match only recent tax actions by other players
-            if (action == "tax")
-            {
-                std::shared_ptr<Player> &target = game.get_player(actor);
-                if (target->is_eliminated())
-                {
-                    throw TargetIsEliminatedException();
-                }
-
-                if (name == actor)
-                {
-                    throw CannotUndoOwnActionException(name, "tax");
-                }
-                
-                if ((global_turn - round) > (players_count - 1))
-                {
-                    throw ActionTooOldException(actor, "tax");
-                }
-
-                int amount = (target->role() == "Governor") ? 3 : 2; // Governor taxed 3, others 2
-                target->decrease_coins(amount);                      // Remove coins from target
-                std::string message = name + " canceled " + target->get_name() + "'s tax. " +
-                                      std::to_string(amount) + " coins were removed.";
-
-                history.erase(std::next(it).base()); // Remove action from history
-                mark_undo_tax_used();                // Mark as used this round
-                std::cout << name << " preformed undo-tax on " << target->get_name() << "! \n"
-                          << std::endl;
-                return message;
-            }
+            return ActionStatus::CannotUndoOwnAction;
         }
 
-        throw NoRecentActionToUndoException("tax"); // No valid tax found
+        if ((global_turn - static_cast<int>(tax.turn)) > (players_count - 1))
+        {
+            return ActionStatus::ActionTooOld;
+        }
+
+        if (target->get_coins() < tax.amount)
+        {
+            return ActionStatus::NotEnoughCoins; // The coins were already spent
+        }
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Cancels the most recent tax by another player if the rules allow it.
+     * @param taxed If not null, receives the id of the player whose tax was examined (kNoPlayer if none).
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Governor::try_undo_tax(PlayerId *taxed)
+    {
+        PlayerId found = kNoPlayer;
+        ActionStatus status = check_undo_tax(&found);
+        if (taxed)
+            *taxed = found;
+        if (status != ActionStatus::Ok)
+            return status;
+
+        int amount = game.get_last_tax(found).amount; // Governor taxed 3, others 2
+        player_at(found)->decrease_coins(amount);      // Remove coins from target
+        game.cancel_latest_tax();
+        mark_undo_tax_used(); // Mark as used this round
+        game.emit(EventType::UndoTax, get_id(), found, amount);
+        return ActionStatus::Ok;
     }
 
     /**
@@ -2,7 +2,6 @@
 #include "Judge.hpp"
 #include "Game.hpp"
 #include "exceptions.hpp"
-#include <iostream>
 
 namespace coup
 {
@@ -12,7 +11,7 @@ namespace coup
      * @param game Reference to the Game instance.
      * @param name Name of the player.
      */
-    Judge::Judge(Game &game, const std::string &name) : Player(game, name) {}
+    Judge::Judge(Game &game, const std::string &name) : Player(game, name, RoleId::Judge) {}
 
     /**
      * @brief Destructor for the Judge class.
@@ -35,52 +34,87 @@ namespace coup
      * @throws InvalidBribeUndoException If target has more than one extra turn (invalid state).
      */
     std::string Judge::undo_bribe(const std::shared_ptr<Player>& target)
+    {
+        bool took_effect = target->get_extra_turns() == 0;
+        ActionStatus status = try_undo_bribe(target->get_id());
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::UndoBribe, target.get());
+
+        if (took_effect)
+            return name + " has canceled " + target->get_name() + "'s bribe (after it took effect).";
+        return name + " has canceled " + target->get_name() + "'s bribe.";
+    }
+
+    /**
+     * @brief Checks whether cancelling a player's bribe is allowed right now.
+     * @param target Id of the player whose bribe would be undone.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Judge::check_undo_bribe(PlayerId target) const
     {
         if (is_eliminated())
         {
-            throw PlayerEliminatedException(name); // Judge is eliminated
+            return ActionStatus::PlayerEliminated; // Judge is eliminated
         }
 
-        if (!target->is_used_bribe())
+        const Player *briber = player_at(target);
+        if (briber == nullptr)
         {
-            throw UndoNotAllowedException(target->get_name(), " bribe"); // Target didn't bribe
+            return ActionStatus::InvalidTarget;
         }
 
-        if (target->get_name() == this->get_name())
+        if (!briber->is_used_bribe())
         {
-            throw CannotUndoOwnActionException(name, "bribe"); // Cannot undo own bribe
+            return ActionStatus::NotUndoable; // Target didn't bribe
         }
 
-        if (!can_undo_bribe())
+        if (target == get_id())
         {
-            throw ActionAlreadyUsedThisRoundException(name, "UNDO BRIBE"); // Already used this round
+            return ActionStatus::CannotUndoOwnAction; // Cannot undo own bribe
         }
 
-        if (target->is_eliminated())
+        if (!can_undo_bribe())
         {
-            throw TargetIsEliminatedException(); // Can't undo eliminated player
+            return ActionStatus::AbilityUsed; // Already used this round
         }
 
-        std::string msg;
+        if (briber->is_eliminated())
+        {
+            return ActionStatus::TargetEliminated; // Can't undo eliminated player
+        }
 
-        if (target->get_extra_turns() == 1)
+        if (briber->get_extra_turns() != 0 && briber->get_extra_turns() != 1)
         {
-            msg = name + " has canceled " + target->get_name() + "'s bribe.";
-            target->set_extra_turns(0); // Remove extra turn
+            return ActionStatus::InvalidBribeUndo; // Unexpected state
         }
-        else if (target->get_extra_turns() == 0)
+
+        return ActionStatus::Ok;
+    }
+
+    /**
+     * @brief Cancels a player's bribe if the rules allow it.
+     * @param target Id of the player whose bribe is undone.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Judge::try_undo_bribe(PlayerId target)
+    {
+        ActionStatus status = check_undo_bribe(target);
+        if (status != ActionStatus::Ok)
+            return status;
+
+        Player *briber = player_at(target);
+        if (briber->get_extra_turns() == 1)
         {
-            msg = name + " has canceled " + target->get_name() + "'s bribe (after it took effect).";
-            game.next_turn(); // Force turn advance if bribe already took effect
+            briber->set_extra_turns(0); // Remove extra turn
         }
         else
         {
-            throw InvalidBribeUndoException(); // Unexpected state
+            game.next_turn(); // Force turn advance if bribe already took effect
         }
 
         mark_undo_bribe_used(); // Prevent further undo this round
-        std::cout << name << " preformed undo-bribe on " << target->get_name() << "! \n" << std::endl;
-        return msg;
+        game.emit(EventType::UndoBribe, get_id(), target);
+        return ActionStatus::Ok;
     }
 
     /**
@@ -0,0 +1,72 @@
+// Author: noapatito123@gmail.com
+#include "RoleFactory.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Judge.hpp"
+#include "Merchant.hpp"
+#include <stdexcept>
+
+namespace coup
+{
+
+    /**
+     * @brief Looks up a role by its name.
+     * @param role Role name (e.g., "Governor", "Spy").
+     * @return RoleId The matching role.
+     * @throws std::invalid_argument if the role name is unknown.
+     */
+    RoleId role_from_name(const std::string &role)
+    {
+        for (std::size_t i = 0; i < kRoleCount; ++i)
+        {
+            if (role == kRoleTraits[i].name)
+                return static_cast<RoleId>(i);
+        }
+        throw std::invalid_argument("Unknown role: " + role);
+    }
+
+    /**
+     * @brief Creates a new player object for the given role.
+     * @param game Reference to the game the player belongs to.
+     * @param role Role name (e.g., "Governor", "Spy").
+     * @param name Player's name.
+     * @return std::shared_ptr<Player> The newly created (not yet added) player.
+     * @throws std::invalid_argument if the role name is unknown.
+     */
+    std::shared_ptr<Player> create_player(Game &game, const std::string &role, const std::string &name)
+    {
+        return create_player(game, role_from_name(role), name);
+    }
+
+    /**
+     * @brief Creates a new player object for the given role.
+     * @param game Reference to the game the player belongs to.
+     * @param role The player's role.
+     * @param name Player's name.
+     * @return std::shared_ptr<Player> The newly created (not yet added) player.
+     * @throws std::invalid_argument if the role is out of range.
+     */
+    std::shared_ptr<Player> create_player(Game &game, RoleId role, const std::string &name)
+    {
+        switch (role)
+        {
+        case RoleId::Governor:
+            return std::make_shared<Governor>(game, name);
+        case RoleId::Spy:
+            return std::make_shared<Spy>(game, name);
+        case RoleId::Baron:
+            return std::make_shared<Baron>(game, name);
+        case RoleId::General:
+            return std::make_shared<General>(game, name);
+        case RoleId::Judge:
+            return std::make_shared<Judge>(game, name);
+        case RoleId::Merchant:
+            return std::make_shared<Merchant>(game, name);
+        default:
+            throw std::invalid_argument("Unknown role");
+        }
+    }
+
+}
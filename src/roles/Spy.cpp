@@ -2,7 +2,6 @@
 #include "Spy.hpp"
 #include "Game.hpp"
 #include "exceptions.hpp"
-#include <iostream>
 
 namespace coup
 {
@@ -12,7 +11,7 @@ namespace coup
      * @param game Reference to the Game instance.
      * @param name Player's name.
      */
-    Spy::Spy(Game &game, const std::string &name) : Player(game, name) {}
+    Spy::Spy(Game &game, const std::string &name) : Player(game, name, RoleId::Spy) {}
 
     /**
      * @brief Destructor for the Spy class.
@@ -32,28 +31,60 @@ namespace coup
      * @throws ActionAlreadyUsedThisRoundException if Spy already used this action this round.
      */
     std::string Spy::peek_and_disable(const std::shared_ptr<Player>& target)
+    {
+        ActionStatus status = try_peek_and_disable(target->get_id());
+        if (status != ActionStatus::Ok)
+            raise(status, ActionKind::PeekAndDisable, target.get());
+
+        return this->get_name() + " peeked and disabled " + target->get_name() +
+               " (Coins: " + std::to_string(target->get_coins()) + ")";
+    }
+
+    /**
+     * @brief Checks whether peeking at a player is allowed right now.
+     * @param target Id of the player to peek at.
+     * @return ActionStatus Ok, or why the action would be refused.
+     */
+    ActionStatus Spy::check_peek_and_disable(PlayerId target) const
     {
         if (is_eliminated())
-            throw PlayerEliminatedException(name); 
+            return ActionStatus::PlayerEliminated;
+
+        const Player *victim = player_at(target);
+        if (victim == nullptr)
+            return ActionStatus::InvalidTarget;
+
+        if (target == get_id())
+            return ActionStatus::CannotTargetYourself;
 
-        if (target->get_name() == this->get_name())
-            throw CannotTargetYourselfException(); 
-        
         if (!can_peek_and_disable())
-            throw ActionAlreadyUsedThisRoundException(name, "peek and disable");
+            return ActionStatus::AbilityUsed;
+
+        if (victim->is_eliminated())
+            return ActionStatus::TargetEliminated;
+
+        return ActionStatus::Ok;
+    }
 
-        if (target->is_eliminated())
-            throw TargetIsEliminatedException();
+    /**
+     * @brief Peeks at and disables a player if the rules allow it.
+     * @param target Id of the player to peek at.
+     * @return ActionStatus Ok, or why the action was refused (nothing changes then).
+     */
+    ActionStatus Spy::try_peek_and_disable(PlayerId target)
+    {
+        ActionStatus status = check_peek_and_disable(target);
+        if (status != ActionStatus::Ok)
+            return status;
 
-        target->set_disable_to_arrest(true); // Prevent arrest
-        target->set_disable_arrest_turns(1); // Only for 1 turn
+        Player *victim = player_at(target);
+        victim->set_disable_to_arrest(true); // Prevent arrest
+        victim->set_disable_arrest_turns(1); // Only for 1 turn
 
         mark_peek_and_disable_used(); // Mark action used for this round
 
-        std::string result = this->get_name() + " peeked and disabled " + target->get_name() +
-                             " (Coins: " + std::to_string(target->get_coins()) + ")";
-        std::cout << name << " preformed peek and disable on " << target->get_name() << "! \n" << std::endl;       
-        return result;
+        game.emit(EventType::PeekAndDisable, get_id(), target, victim->get_coins());
+        return ActionStatus::Ok;
     }
 
     /**
@@ -0,0 +1,347 @@
+// Author: noapatito123@gmail.com
+#include "InfoSet.hpp"
+#include "Governor.hpp"
+#include "Player.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+
+namespace coup
+{
+
+    namespace
+    {
+        // Fewest (most = false) or most coins a role trait gives, over all roles
+        constexpr int trait_bound(int RoleTraits::*trait, bool most)
+        {
+            int bound = kRoleTraits[0].*trait;
+            for (const RoleTraits &traits : kRoleTraits)
+                bound = most ? std::max(bound, traits.*trait) : std::min(bound, traits.*trait);
+            return bound;
+        }
+    }
+
+    /**
+     * @brief Starts following a game for one observer, taking every current count as public.
+     *
+     * Call it where the counts really are known to everyone: at the deal, or
+     * after setting a position up by hand. The turn in progress has had its
+     * turn bonus.
+     *
+     * @param game The game to follow.
+     * @param observer Whose knowledge to keep.
+     */
+    void CoinTracker::reset(const Game &game, PlayerId observer)
+    {
+        const GameState &state = game.get_state();
+        for (PlayerId player = 0; player < state.player_count; ++player)
+        {
+            Bounds &b = players[player];
+            b.min = b.max = state.players[player].coins;
+        }
+        followed = &game;
+        this->observer = observer;
+        seen = game.get_history().total_pushed();
+        turn = state.global_turn_index;
+        current = static_cast<PlayerId>(state.turn_index);
+        alive = state.alive;
+    }
+
+    /**
+     * @brief Takes in every action logged since the last call.
+     *
+     * A different game or observer, a cleared log, a turn counter that went back (a reused
+     * table), entries that fell out of the log unseen or a turn order that no
+     * longer matches the game (turns set by hand) start over with reset().
+     *
+     * @param game The game to follow.
+     * @param observer Whose knowledge to keep.
+     */
+    void CoinTracker::sync(const Game &game, PlayerId observer)
+    {
+        const ActionHistory &log = game.get_history();
+        const GameState &state = game.get_state();
+        std::uint64_t total = log.total_pushed();
+        if (followed != &game || observer != this->observer || total < seen || total - seen > log.size() || state.global_turn_index < turn)
+        {
+            reset(game, observer);
+            return;
+        }
+        for (std::size_t i = log.size() - static_cast<std::size_t>(total - seen); i < log.size(); ++i)
+            observe(log[i], state);
+        seen = total;
+        advance(state.global_turn_index, state); // Turns passed without a logged action
+        if (current != state.turn_index || alive != state.alive)
+            reset(game, observer);
+    }
+
+    /**
+     * @brief Applies one logged action to the bounds.
+     *
+     * The entry's amount is what the actor gained or paid, but only payments and
+     * the observer's own income are taken from it; other players' income from the
+     * bank is counted as a range. The target's side of an arrest or a sanction
+     * follows from its role. Turns started since the last entry are settled
+     * first, with their bonuses.
+     *
+     * @param entry The logged action.
+     * @param state The game's state (only public parts are read: roles).
+     */
+    void CoinTracker::observe(const HistoryEntry &entry, const GameState &state)
+    {
+        PlayerId actor = entry.actor;
+        PlayerId target = entry.target;
+        advance(entry.turn, state);
+        switch (entry.kind)
+        {
+        case ActionKind::UndoTax:
+            pay(target, entry.amount);
+            break;
+        case ActionKind::UndoBribe:
+            break;
+        case ActionKind::UndoCoup:
+            pay(actor, entry.amount);
+            alive |= player_bit(target);
+            break;
+        case ActionKind::PeekAndDisable:
+            if (actor == observer)
+                set_bounds(target, entry.amount, entry.amount); // The peek shows the count
+            break;
+        case ActionKind::Gather:
+            gain(actor, entry.amount);
+            break;
+        case ActionKind::Tax:
+            income(actor, entry.amount, trait_bound(&RoleTraits::tax_amount, false), trait_bound(&RoleTraits::tax_amount, true));
+            break;
+        case ActionKind::Invest:
+            prove(actor, kInvestCost);
+            gain(actor, entry.amount);
+            break;
+        case ActionKind::Arrest:
+        {
+            const RoleTraits &traits = role_traits(state.players[target].role);
+            prove(target, traits.arrest_min_coins);
+            pay(target, traits.arrest_loss);
+            gain(actor, entry.amount);
+            break;
+        }
+        case ActionKind::Sanction:
+            pay(actor, entry.amount);
+            income(target, role_traits(state.players[target].role).sanction_refund,
+                   trait_bound(&RoleTraits::sanction_refund, false), trait_bound(&RoleTraits::sanction_refund, true));
+            break;
+        case ActionKind::Coup:
+            pay(actor, entry.amount);
+            alive &= ~player_bit(target);
+            break;
+        default: // Bribe
+            pay(actor, entry.amount);
+            break;
+        }
+    }
+
+    /**
+     * @brief Sets a player's public bounds by hand.
+     * @param player The player.
+     * @param min_coins Fewest coins the table allows for.
+     * @param max_coins Most coins the table allows for (at least min_coins).
+     */
+    void CoinTracker::set_bounds(PlayerId player, int min_coins, int max_coins)
+    {
+        players[player].min = static_cast<std::int16_t>(min_coins);
+        players[player].max = static_cast<std::int16_t>(std::max(min_coins, max_coins));
+    }
+
+    /**
+     * @brief Adds announced income.
+     * @param player Who gained.
+     * @param amount Coins gained.
+     */
+    void CoinTracker::gain(PlayerId player, int amount)
+    {
+        players[player].min += amount;
+        players[player].max += amount;
+    }
+
+    /**
+     * @brief Adds income taken from the bank in private.
+     * @param player Who gained.
+     * @param amount Coins gained (known only to the player, and so to an observer who is the player).
+     * @param least Fewest coins the others allow for.
+     * @param most Most coins the others allow for.
+     */
+    void CoinTracker::income(PlayerId player, int amount, int least, int most)
+    {
+        if (player == observer)
+        {
+            gain(player, amount);
+            return;
+        }
+        players[player].min += least;
+        players[player].max += most;
+    }
+
+    /**
+     * @brief Subtracts an announced payment, which proves the coins were there.
+     * @param player Who paid.
+     * @param amount Coins paid.
+     */
+    void CoinTracker::pay(PlayerId player, int amount)
+    {
+        prove(player, amount);
+        gain(player, -amount);
+    }
+
+    /**
+     * @brief Raises the lower bound to a count the rules proved (and the upper bound with it if needed).
+     * @param player The player.
+     * @param at_least Coins the player was shown to hold.
+     */
+    void CoinTracker::prove(PlayerId player, int at_least)
+    {
+        Bounds &b = players[player];
+        if (b.min < at_least)
+            b.min = static_cast<std::int16_t>(at_least);
+        if (b.max < b.min)
+            b.max = b.min;
+    }
+
+    /**
+     * @brief Starts every turn after the last settled one, up to a global turn.
+     *
+     * The rules pay the turn bonus each time a turn starts (Game::next_turn),
+     * including turns forced by an undone bribe and turns that end in a pass, none
+     * of which is announced. Turns go to the next player in the game, so the
+     * tracker replays the turn order itself and settles the bonus once per global
+     * turn. Extra turns do not advance the global turn and pay no bonus.
+     *
+     * @param to Global turn to settle up to.
+     * @param state The game's state (only public parts are read: roles).
+     */
+    void CoinTracker::advance(std::uint32_t to, const GameState &state)
+    {
+        for (; turn < to && alive != 0; ++turn)
+        {
+            current = mask_next(alive, current);
+            turn_bonus(current, state.players[current].role);
+        }
+    }
+
+    /**
+     * @brief Settles the turn bonus of one turn start.
+     *
+     * The bonus is paid in silence when the count reaches the role's threshold:
+     * it is certain above the bounds, impossible below them, and hidden in between.
+     *
+     * @param player Whose turn started.
+     * @param role The player's role.
+     */
+    void CoinTracker::turn_bonus(PlayerId player, RoleId role)
+    {
+        Bounds &b = players[player];
+        int threshold = role_traits(role).turn_bonus_threshold;
+        if (threshold == 0 || b.max < threshold)
+            return;
+        if (b.min >= threshold)
+            b.min++;
+        b.max++;
+    }
+
+    /**
+     * @brief Tells whether the observer knows a player's exact coin count: their
+     *        own, or one its bounds pin down (after a peek, for instance).
+     * @param player The player asked about.
+     * @return true if the exact count is known.
+     */
+    bool InfoSetView::knows_coins(PlayerId player) const
+    {
+        return player == observer || tracker.min_coins(player) == tracker.max_coins(player);
+    }
+
+    /**
+     * @brief Fewest coins the player may have, as far as the observer knows.
+     * @param player The player asked about.
+     * @return int The lower bound (the exact count if known).
+     */
+    int InfoSetView::min_coins(PlayerId player) const
+    {
+        return player == observer ? game.get_state().players[player].coins : tracker.min_coins(player);
+    }
+
+    /**
+     * @brief Most coins the player may have, as far as the observer knows.
+     * @param player The player asked about.
+     * @return int The upper bound (the exact count if known).
+     */
+    int InfoSetView::max_coins(PlayerId player) const
+    {
+        return player == observer ? game.get_state().players[player].coins : tracker.max_coins(player);
+    }
+
+    /**
+     * @brief Exact coin count of a player if the observer knows it.
+     * @param player The player asked about.
+     * @return int The count, or -1 if it is hidden.
+     */
+    int InfoSetView::coins(PlayerId player) const
+    {
+        return knows_coins(player) ? min_coins(player) : -1;
+    }
+
+    /**
+     * @brief Lists the observer's moves that may be legal as far as it knows.
+     *
+     * An arrest needs the target to hold a minimum count, and undoing a tax needs
+     * the taxer to hold the taxed coins, so the rules alone would tell the
+     * observer about hidden counts. Those moves are listed when the bounds allow
+     * them (a tax brings at least the smallest amount of any role). The rules may
+     * still refuse such a move for real; the caller then picks another.
+     *
+     * @return ActionSet The moves the rules may accept.
+     */
+    ActionSet InfoSetView::legal_actions() const
+    {
+        ActionSet legal = game.legal_actions(observer);
+        const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+        if (observer >= players.size())
+            return legal;
+        const Player &self = *players[observer];
+        const GameState &state = game.get_state();
+        for (PlayerId target = 0; target < state.player_count; ++target)
+            if (self.check_arrest(target) == ActionStatus::TargetNoCoins &&
+                max_coins(target) >= role_traits(state.players[target].role).arrest_min_coins)
+                legal.add(ActionKind::Arrest, target);
+
+        PlayerId taxed = kNoPlayer;
+        if (self.role_id() == RoleId::Governor &&
+            static_cast<const Governor &>(self).check_undo_tax(&taxed) == ActionStatus::NotEnoughCoins &&
+            max_coins(taxed) >= trait_bound(&RoleTraits::tax_amount, false))
+            legal.add(ActionKind::UndoTax);
+        return legal;
+    }
+
+    /**
+     * @brief Samples one determinization: the real public state with every
+     *        hidden coin count drawn uniformly from its bounds.
+     *
+     * Only public bounds and the observer's own knowledge are used, so a search
+     * run on the result cannot peek at hidden information. The position hash is
+     * recomputed for the sampled coins.
+     *
+     * @param out Receives the sampled state (no allocation).
+     * @param rng Random engine.
+     */
+    void InfoSetView::determinize(GameState &out, SimRng &rng) const
+    {
+        copy_state(out, game.get_state());
+        for (PlayerId player = 0; player < out.player_count; ++player)
+        {
+            if (player == observer)
+                continue;
+            int low = tracker.min_coins(player);
+            int span = tracker.max_coins(player) - low + 1;
+            out.players[player].coins = static_cast<std::int16_t>(low + static_cast<int>(rng() % span));
+        }
+        out.hash = hash_state(out);
+    }
+
+}
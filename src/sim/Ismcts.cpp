@@ -0,0 +1,255 @@
+// Author: noapatito123@gmail.com
+#include "Ismcts.hpp"
+#include "Player.hpp"
+#include "SimEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace coup
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        constexpr std::size_t kColumns = kMaxPlayers + 1; // Target columns per action kind (last one is "no target")
+
+        // Slot of a move in a kind x target table
+        std::size_t move_slot(const Action &move)
+        {
+            return static_cast<std::size_t>(move.kind) * kColumns + (move.target == kNoTarget ? kMaxPlayers : move.target);
+        }
+    }
+
+    // One search thread: a private game, a node pool and scratch buffers, all reused between searches
+    struct IsmctsSearch::Worker
+    {
+        struct Node
+        {
+            Action move{ActionKind::Count, kNoPlayer, kNoTarget}; // Move leading here; its actor owns the rewards
+            std::uint32_t visits = 0;                             // Playouts through the node
+            std::uint32_t availability = 0;                       // Playouts in which the move was legal
+            double reward = 0;                                    // Sum of the mover's rewards
+            std::uint32_t first_child = 0;                        // First child (0 = none)
+            std::uint32_t next_sibling = 0;                       // Next child of the parent (0 = none)
+        };
+
+        std::unique_ptr<Game> game;       // Private copy of the searched game
+        std::vector<Node> nodes;          // Node pool; nodes[0] is the root
+        std::size_t used = 1;             // Nodes handed out
+        std::vector<std::uint32_t> path;  // Nodes visited by the current playout
+        GameState sample;                 // Current determinization
+        SimRng rng;                       // Private random engine
+        std::size_t playouts = 0;         // Playouts of the current search
+
+        explicit Worker(std::size_t capacity) : nodes(std::max<std::size_t>(capacity, 1)) { path.reserve(256); }
+
+        void reset(const Game &other, const SimRng &stream); // Prepare for a new search
+        void playout(const InfoSetView &view, const MctsConfig &config); // One determinize / select / expand / rollout / backup pass
+    };
+
+    /**
+     * @brief Empties the tree and gives the worker a new random stream; the game copy
+     *        is rebuilt only if the table changed.
+     * @param other The game about to be searched.
+     * @param stream The worker's random stream for this search.
+     */
+    void IsmctsSearch::Worker::reset(const Game &other, const SimRng &stream)
+    {
+        if (!game || !same_table(*game, other))
+            game = mirror_game(other);
+        nodes[0] = Node();
+        used = 1;
+        playouts = 0;
+        rng = stream;
+    }
+
+    /**
+     * @brief Runs one playout on a fresh determinization.
+     *
+     * At each node only the children whose move is legal in this sample are
+     * candidates, and their availability counts replace the parent visit count
+     * in the UCB formula. The first legal move without a child is expanded.
+     *
+     * @param view What the searching player knows.
+     * @param config Search settings.
+     */
+    void IsmctsSearch::Worker::playout(const InfoSetView &view, const MctsConfig &config)
+    {
+        view.determinize(sample, rng);
+        game->set_state(sample);
+        path.clear();
+        path.push_back(0);
+
+        std::uint32_t current = 0;
+        while (!game->is_game_over())
+        {
+            ActionSet legal = game->legal_actions();
+            if (legal.empty())
+                break;
+            PlayerId actor = static_cast<PlayerId>(game->get_turn_index());
+
+            ActionSet tried;
+            std::size_t untried = legal.count();
+            std::uint32_t best = 0;
+            double best_score = -1.0;
+            for (std::uint32_t c = nodes[current].first_child; c != 0; c = nodes[c].next_sibling)
+            {
+                Node &child = nodes[c];
+                if (child.move.actor != actor || !legal.allows(child.move.kind, child.move.target))
+                    continue;
+                child.availability++;
+                tried.add(child.move.kind, child.move.target);
+                untried--;
+                double score = child.reward / child.visits +
+                               config.exploration * std::sqrt(std::log(static_cast<double>(child.availability)) / child.visits);
+                if (score > best_score)
+                {
+                    best = c;
+                    best_score = score;
+                }
+            }
+
+            if (untried > 0 && used < nodes.size())
+            {
+                std::size_t pick = rng() % untried;
+                Action chosen{ActionKind::Count, actor, kNoTarget};
+                legal.for_each(actor, [&](const Action &move) {
+                    if (!tried.allows(move.kind, move.target) && pick-- == 0)
+                        chosen = move;
+                });
+                std::uint32_t index = static_cast<std::uint32_t>(used++);
+                Node &child = nodes[index];
+                child = Node();
+                child.move = chosen;
+                child.availability = 1;
+                child.next_sibling = nodes[current].first_child;
+                nodes[current].first_child = index;
+                path.push_back(index);
+                SimEngine::apply(*game, chosen);
+                break; // Expanded: finish with a rollout
+            }
+            if (best == 0)
+                break;
+            path.push_back(best);
+            if (!SimEngine::apply(*game, nodes[best].move))
+                break;
+            current = best;
+        }
+
+        double rewards[kMaxPlayers];
+        rollout(*game, rng, config, rewards);
+        for (std::uint32_t index : path)
+        {
+            Node &node = nodes[index];
+            node.visits++;
+            if (node.move.actor < kMaxPlayers)
+                node.reward += rewards[node.move.actor];
+        }
+        playouts++;
+    }
+
+    /**
+     * @brief Constructs a search; threads and workers are created on the first search.
+     * @param config Search settings.
+     */
+    IsmctsSearch::IsmctsSearch(const MctsConfig &config) : config(config) {}
+
+    /**
+     * @brief Destructor (Worker is only complete in this file).
+     */
+    IsmctsSearch::~IsmctsSearch() {}
+
+    /**
+     * @brief Searches the best move of the observer without looking at hidden coins.
+     *
+     * The observer's coin bounds are first brought up to date from the game's action log.
+     * The search runs on a pool of threads kept between searches. Every task
+     * samples its own determinizations and grows its own tree.
+     * Root visits are summed per move, and the most visited move the observer
+     * may play as far as it knows (InfoSetView::legal_actions) is returned.
+     *
+     * @param game The real game (only what the observer may know is used).
+     * @param observer The player to move.
+     * @param seed Seed of the per-thread random engines.
+     * @return Action The chosen move (gather if nothing is legal).
+     */
+    Action IsmctsSearch::search(const Game &game, PlayerId observer, std::uint64_t seed)
+    {
+        Clock::time_point start = Clock::now();
+        last = MctsStats();
+        last.searches = 1;
+
+        coins.sync(game, observer);
+        const InfoSetView view(game, coins);
+        Action best{ActionKind::Gather, observer, kNoTarget};
+        ActionSet legal = view.legal_actions(); // Not the real rules: they would tell hidden counts
+        if (legal.count() <= 1 || game.is_game_over())
+        {
+            legal.for_each(observer, [&best](const Action &action) { best = action; });
+            return best; // Nothing to choose
+        }
+
+        const std::size_t threads = std::max<std::size_t>(config.threads, 1);
+        const std::size_t budget = config.playouts == 0 && config.seconds <= 0 ? 1 : config.playouts;
+        while (workers.size() < threads)
+            workers.emplace_back(new Worker(config.max_nodes));
+        for (std::size_t t = 0; t < threads; ++t)
+            workers[t]->reset(game, SimRng(seed, t));
+
+        std::atomic<std::size_t> claimed{0};
+        if (!pool)
+            pool.reset(new WorkStealingPool(threads));
+        pool->run(threads, [&](std::size_t, std::size_t task) {
+            Worker &worker = *workers[task];
+            for (std::size_t n = 0;; ++n)
+            {
+                if (budget > 0 && claimed.fetch_add(1, std::memory_order_relaxed) >= budget)
+                    break;
+                if (config.seconds > 0 && n % 16 == 0 &&
+                    std::chrono::duration<double>(Clock::now() - start).count() >= config.seconds)
+                    break;
+                worker.playout(view, config);
+            }
+        });
+
+        std::uint64_t visits[kActionKindCount * kColumns] = {};
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            const Worker &worker = *workers[t];
+            last.playouts += worker.playouts;
+            last.nodes += worker.used;
+            for (std::uint32_t c = worker.nodes[0].first_child; c != 0; c = worker.nodes[c].next_sibling)
+                visits[move_slot(worker.nodes[c].move)] += worker.nodes[c].visits;
+        }
+
+        // A move that was legal only in some samples may be refused for real; the caller then asks again
+        std::uint64_t most = 0;
+        legal.for_each(observer, [&](const Action &action) {
+            if (visits[move_slot(action)] > most)
+            {
+                most = visits[move_slot(action)];
+                best = action;
+            }
+        });
+
+        last.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return best;
+    }
+
+    /**
+     * @brief Searches a move for this seat and adds the search to the totals.
+     */
+    Action IsmctsStrategy::choose_action(const Game &game, PlayerId self, SimRng &rng)
+    {
+        Action action = searcher.search(game, self, rng());
+        const MctsStats &last = searcher.last_stats();
+        total.searches += last.searches;
+        total.playouts += last.playouts;
+        total.nodes += last.nodes;
+        total.seconds += last.seconds;
+        return action;
+    }
+
+}
@@ -0,0 +1,374 @@
+// Author: noapatito123@gmail.com
+#include "Mcts.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "SimEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace coup
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        constexpr std::size_t kMaxMoves = kActionKindCount * (kMaxPlayers + 1); // Most (action, target) pairs a player can have
+        constexpr double kRewardScale = 65536.0;                                // Fixed-point scale of node rewards
+    }
+
+    /**
+     * @brief Builds a private copy of a game (same roles, names and state) for one search thread.
+     * @param game The game to copy.
+     * @return std::unique_ptr<Game> The copy; it has no event sink.
+     */
+    std::unique_ptr<Game> mirror_game(const Game &game)
+    {
+        std::unique_ptr<Game> copy(new Game(game.get_max_players()));
+        for (const std::shared_ptr<Player> &player : game.get_all_players())
+            copy->add_player(create_player(*copy, player->role_id(), player->get_name()));
+        copy->set_state(game.get_state());
+        return copy;
+    }
+
+    /**
+     * @brief Checks whether a private copy has the same seats and roles as a game.
+     * @param copy The copy kept from an earlier search.
+     * @param game The game about to be searched.
+     * @return true if the copy can be reused by copying state only.
+     */
+    bool same_table(const Game &copy, const Game &game)
+    {
+        const std::vector<std::shared_ptr<Player>> &ours = copy.get_all_players();
+        const std::vector<std::shared_ptr<Player>> &theirs = game.get_all_players();
+        if (ours.size() != theirs.size())
+            return false;
+        for (std::size_t i = 0; i < theirs.size(); ++i)
+            if (ours[i]->role_id() != theirs[i]->role_id())
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Plays to the end of the game or the ply limit, mixing GreedyStrategy
+     *        moves with uniformly random legal moves, and scores the result.
+     *
+     * The winner gets 1; an unfinished game is shared equally by the survivors.
+     *
+     * @param game The game to finish (modified).
+     * @param rng Random engine.
+     * @param config Ply limit and greedy share.
+     * @param rewards Receives each player's reward.
+     */
+    void rollout(Game &game, SimRng &rng, const MctsConfig &config, double rewards[kMaxPlayers])
+    {
+        static GreedyStrategy greedy; // Stateless
+        const std::uint64_t greedy_cut = static_cast<std::uint64_t>(config.greedy_rollouts * 1024);
+        for (std::size_t ply = 0; ply < config.rollout_limit && !game.is_game_over(); ++ply)
+        {
+            PlayerId current = static_cast<PlayerId>(game.get_turn_index());
+            if ((rng() & 1023) < greedy_cut && SimEngine::apply(game, greedy.choose_action(game, current, rng)))
+                continue;
+
+            ActionSet legal = game.legal_actions();
+            std::size_t count = legal.count();
+            if (count == 0)
+            {
+                game.pass_turn(); // No legal move
+                continue;
+            }
+            std::size_t pick = rng() % count;
+            Action chosen{ActionKind::Gather, kNoPlayer, kNoTarget};
+            std::size_t index = 0;
+            legal.for_each(current, [&](const Action &action) {
+                if (index++ == pick)
+                    chosen = action;
+            });
+            if (!SimEngine::apply(game, chosen))
+                game.pass_turn();
+        }
+
+        // The winner takes all; an unfinished game is shared by the survivors
+        PlayerMask alive = game.get_alive_mask();
+        double share = alive ? 1.0 / mask_count(alive) : 0.0;
+        for (PlayerId player = 0; player < kMaxPlayers; ++player)
+            rewards[player] = (alive & player_bit(player)) ? share : 0.0;
+    }
+
+    // Node pool of one search tree
+    struct MctsSearch::Tree
+    {
+        struct Node
+        {
+            Action move{ActionKind::Count, kNoPlayer, kNoTarget}; // Move leading here; its actor owns the rewards
+            std::atomic<std::uint32_t> visits{0};                 // Playouts through the node, plus pending virtual losses
+            std::atomic<std::uint64_t> reward{0};                 // Sum of the mover's rewards (fixed point)
+            std::uint32_t first_child = 0;                        // Index of the first child (valid once expanded)
+            std::uint32_t child_count = 0;                        // Number of children (valid once expanded)
+            std::atomic<std::uint8_t> expansion{0};               // 0 = leaf, 1 = being expanded, 2 = expanded
+        };
+
+        std::vector<Node> nodes;          // The pool; nodes[0] is the root
+        std::atomic<std::size_t> used{1}; // Nodes handed out
+
+        explicit Tree(std::size_t capacity) : nodes(std::max<std::size_t>(capacity, 1)) {}
+
+        void reset();                                        // Start a new search from an empty root
+        void expand(Node &node, const Game &game);           // Create the children of node
+        std::uint32_t select(const Node &node, double exploration) const; // UCT choice among the children
+        void playout(Game &game, const GameState &root, SimRng &rng, const MctsConfig &config,
+                     std::vector<std::uint32_t> &path);       // One select / expand / rollout / backup pass
+    };
+
+    /**
+     * @brief Empties the tree, keeping its node pool allocated.
+     */
+    void MctsSearch::Tree::reset()
+    {
+        Node &root = nodes[0];
+        root.visits.store(0, std::memory_order_relaxed);
+        root.reward.store(0, std::memory_order_relaxed);
+        root.child_count = 0;
+        root.expansion.store(0, std::memory_order_relaxed);
+        used.store(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Creates one child per legal move of the player to move. If the
+     *        pool is full the node gets no children and stays a leaf.
+     * @param node The node to expand (the caller owns its expansion flag).
+     * @param game The game positioned at node.
+     */
+    void MctsSearch::Tree::expand(Node &node, const Game &game)
+    {
+        Action moves[kMaxMoves];
+        std::size_t count = 0;
+        game.legal_actions().for_each(static_cast<PlayerId>(game.get_turn_index()), [&](const Action &action) { moves[count++] = action; });
+
+        std::size_t first = used.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > nodes.size())
+            count = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Node &child = nodes[first + i];
+            child.move = moves[i];
+            child.visits.store(0, std::memory_order_relaxed);
+            child.reward.store(0, std::memory_order_relaxed);
+            child.child_count = 0;
+            child.expansion.store(0, std::memory_order_relaxed);
+        }
+        node.first_child = static_cast<std::uint32_t>(first);
+        node.child_count = static_cast<std::uint32_t>(count);
+        node.expansion.store(2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Picks the child with the best UCT score for the player to move.
+     *        Unvisited children come first; pending virtual losses count as visits
+     *        without reward, which steers other threads elsewhere.
+     * @param node An expanded node with at least one child.
+     * @param exploration UCT exploration constant.
+     * @return std::uint32_t Index of the chosen child.
+     */
+    std::uint32_t MctsSearch::Tree::select(const Node &node, double exploration) const
+    {
+        double log_parent = std::log(std::max<double>(node.visits.load(std::memory_order_relaxed), 1.0));
+        std::uint32_t best = node.first_child;
+        double best_score = -1.0;
+        for (std::uint32_t i = node.first_child; i < node.first_child + node.child_count; ++i)
+        {
+            const Node &child = nodes[i];
+            std::uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            if (visits == 0)
+                return i;
+            double mean = child.reward.load(std::memory_order_relaxed) / kRewardScale / visits;
+            double score = mean + exploration * std::sqrt(log_parent / visits);
+            if (score > best_score)
+            {
+                best = i;
+                best_score = score;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Runs one playout: descends by UCT, expands the first leaf, plays
+     *        randomly to the end and credits every node with its mover's reward.
+     * @param game Thread-private game, reset to root first.
+     * @param root State at the root of the tree.
+     * @param rng Thread-private random engine.
+     * @param config Search settings.
+     * @param path Scratch buffer for the visited nodes (reused between playouts).
+     */
+    void MctsSearch::Tree::playout(Game &game, const GameState &root, SimRng &rng, const MctsConfig &config,
+                                   std::vector<std::uint32_t> &path)
+    {
+        const std::uint32_t loss = std::max<std::uint32_t>(config.virtual_loss, 1);
+        game.set_state(root);
+        path.clear();
+        path.push_back(0);
+        nodes[0].visits.fetch_add(loss, std::memory_order_relaxed);
+
+        std::uint32_t current = 0;
+        while (!game.is_game_over())
+        {
+            Node &node = nodes[current];
+            std::uint8_t expansion = node.expansion.load(std::memory_order_acquire);
+            if (expansion == 0)
+            {
+                if (!node.expansion.compare_exchange_strong(expansion, 1, std::memory_order_acq_rel))
+                    break; // Another thread is expanding it: play out from here
+                expand(node, game);
+            }
+            else if (expansion == 1)
+                break;
+            if (node.child_count == 0)
+                break;
+
+            std::uint32_t child = select(node, config.exploration);
+            Node &next = nodes[child];
+            bool fresh = next.visits.fetch_add(loss, std::memory_order_relaxed) == 0;
+            path.push_back(child);
+            if (!SimEngine::apply(game, next.move))
+                break;
+            current = child;
+            if (fresh)
+                break;
+        }
+
+        double rewards[kMaxPlayers];
+        rollout(game, rng, config, rewards);
+        for (std::uint32_t index : path)
+        {
+            Node &node = nodes[index];
+            if (loss > 1)
+                node.visits.fetch_sub(loss - 1, std::memory_order_relaxed); // Turn the virtual loss into one real visit
+            PlayerId mover = node.move.actor;
+            if (mover < kMaxPlayers)
+                node.reward.fetch_add(static_cast<std::uint64_t>(rewards[mover] * kRewardScale), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Constructs a search; threads and node pools are started on the first search.
+     * @param config Search settings.
+     */
+    MctsSearch::MctsSearch(const MctsConfig &config) : config(config) {}
+
+    /**
+     * @brief Destructor (Tree is only complete in this file).
+     */
+    MctsSearch::~MctsSearch() {}
+
+    /**
+     * @brief Searches the best move of the player whose turn it is.
+     *
+     * The search runs on a pool of threads kept between searches. Every pool
+     * worker plays on its own mirror of the game, rebuilt only when the table
+     * changes and otherwise reset with set_state. Task i works on tree i % trees;
+     * tasks sharing a tree use virtual loss. The move whose root
+     * child has the most visits over all trees is returned.
+     *
+     * @param game The position to search (not modified).
+     * @param seed Seed of the per-thread random engines.
+     * @return Action The chosen move (gather if the player has no legal move).
+     */
+    Action MctsSearch::search(const Game &game, std::uint64_t seed)
+    {
+        Clock::time_point start = Clock::now();
+        last = MctsStats();
+        last.searches = 1;
+
+        PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+        Action best{ActionKind::Gather, actor, kNoTarget};
+        ActionSet legal = game.legal_actions();
+        if (legal.count() <= 1 || game.is_game_over())
+        {
+            legal.for_each(actor, [&best](const Action &action) { best = action; });
+            return best; // Nothing to choose
+        }
+
+        const std::size_t threads = std::max<std::size_t>(config.threads, 1);
+        const std::size_t tree_count = std::min(std::max<std::size_t>(config.trees, 1), threads);
+        const std::size_t budget = config.playouts == 0 && config.seconds <= 0 ? 1 : config.playouts;
+        while (trees.size() < tree_count)
+            trees.emplace_back(new Tree(config.max_nodes));
+        for (std::size_t t = 0; t < tree_count; ++t)
+            trees[t]->reset();
+
+        if (!pool)
+            pool.reset(new WorkStealingPool(threads));
+        mirrors.resize(pool->size());
+        paths.resize(pool->size());
+        for (std::size_t w = 0; w < pool->size(); ++w)
+        {
+            if (!mirrors[w] || !same_table(*mirrors[w], game))
+                mirrors[w] = mirror_game(game);
+            paths[w].reserve(64);
+        }
+
+        const GameState root = game.get_state();
+        std::atomic<std::size_t> claimed{0};
+        std::atomic<std::size_t> done{0};
+        pool->run(threads, [&](std::size_t worker, std::size_t task) {
+            SimRng rng(seed, task);
+            Tree &tree = *trees[task % tree_count];
+            for (std::size_t n = 0;; ++n)
+            {
+                if (budget > 0 && claimed.fetch_add(1, std::memory_order_relaxed) >= budget)
+                    break;
+                if (config.seconds > 0 && n % 16 == 0 &&
+                    std::chrono::duration<double>(Clock::now() - start).count() >= config.seconds)
+                    break;
+                tree.playout(*mirrors[worker], root, rng, config, paths[worker]);
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        // Root parallelism: every tree enumerated the same root moves in the same order
+        std::uint64_t visits[kMaxMoves] = {};
+        const Tree *reference = nullptr;
+        for (std::size_t t = 0; t < tree_count; ++t)
+        {
+            const Tree &tree = *trees[t];
+            const Tree::Node &node = tree.nodes[0];
+            last.nodes += std::min(tree.used.load(std::memory_order_relaxed), tree.nodes.size());
+            if (node.expansion.load(std::memory_order_acquire) != 2 || node.child_count == 0)
+                continue;
+            reference = &tree;
+            for (std::uint32_t i = 0; i < node.child_count; ++i)
+                visits[i] += tree.nodes[node.first_child + i].visits.load(std::memory_order_relaxed);
+        }
+        if (reference != nullptr)
+        {
+            const Tree::Node &node = reference->nodes[0];
+            std::uint32_t chosen = 0;
+            for (std::uint32_t i = 1; i < node.child_count; ++i)
+                if (visits[i] > visits[chosen])
+                    chosen = i;
+            best = reference->nodes[node.first_child + chosen].move;
+        }
+
+        last.playouts = done.load(std::memory_order_relaxed);
+        last.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return best;
+    }
+
+    /**
+     * @brief Searches a move for the current player and adds the search to the totals.
+     */
+    Action MctsStrategy::choose_action(const Game &game, PlayerId self, SimRng &rng)
+    {
+        Action action = searcher.search(game, rng());
+        const MctsStats &last = searcher.last_stats();
+        total.searches += last.searches;
+        total.playouts += last.playouts;
+        total.nodes += last.nodes;
+        total.seconds += last.seconds;
+        action.actor = self;
+        return action;
+    }
+
+}
@@ -0,0 +1,726 @@
+// Author: noapatito123@gmail.com
+#include "Replay.hpp"
+#include "Player.hpp"
+#include "SimEngine.hpp"
+#include "exceptions.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace coup
+{
+
+    namespace
+    {
+        // Reactions can be played by anyone, so their actor is stored
+        bool stores_actor(EventType type)
+        {
+            return type >= EventType::UndoTax && type <= EventType::PeekAndDisable;
+        }
+
+        std::uint8_t get_byte(const std::uint8_t *&at, const std::uint8_t *end)
+        {
+            if (at == end)
+                throw ReplayFormatException();
+            return *at++;
+        }
+
+        std::uint64_t get_fixed64(const std::uint8_t *&at, const std::uint8_t *end)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < 8; ++i)
+                value |= static_cast<std::uint64_t>(get_byte(at, end)) << (8 * i);
+            return value;
+        }
+
+        // Header fields up to the first record
+        void read_header(const std::uint8_t *&at, const std::uint8_t *end, ReplayInfo &info)
+        {
+            if (get_byte(at, end) != 'C' || get_byte(at, end) != 'R')
+                throw ReplayFormatException();
+            info.version = get_byte(at, end);
+            if (info.version < replay::kOldestVersion || info.version > replay::kVersion)
+                throw ReplayFormatException(); // Unknown (newer) version
+            info.seed = replay::get_varint(at, end);
+            info.stream = replay::get_varint(at, end);
+            std::uint64_t seats = replay::get_varint(at, end);
+            if (seats > kMaxPlayers)
+                throw ReplayFormatException();
+            for (std::uint64_t seat = 0; seat < seats; ++seat)
+            {
+                std::uint8_t role = get_byte(at, end);
+                std::uint64_t length = replay::get_varint(at, end);
+                if (role >= kRoleCount || length > static_cast<std::uint64_t>(end - at))
+                    throw ReplayFormatException();
+                info.roles.push_back(static_cast<RoleId>(role));
+                info.names.emplace_back(reinterpret_cast<const char *>(at), length);
+                at += length;
+            }
+        }
+
+        // Seat the header's players in an empty game
+        void seat(Game &game, const ReplayInfo &info)
+        {
+            if (!game.get_all_players().empty())
+                throw ReplayFormatException();
+            if (info.roles.size() > game.get_max_players())
+                game.set_max_players(info.roles.size()); // Large tables replay into a default game
+            for (std::size_t i = 0; i < info.roles.size(); ++i)
+                game.add_player(create_player(game, info.roles[i], info.names[i]));
+        }
+
+        // Decode one move record (marker bytes excluded) and play it; false if the rules refuse it
+        bool play_record(const std::uint8_t *&at, const std::uint8_t *end, Game &game)
+        {
+            std::uint8_t byte = get_byte(at, end);
+            EventType type = static_cast<EventType>(byte & 0x0F);
+            std::uint64_t target = byte >> 4;
+            if (target == replay::kTargetEscape)
+                target = replay::get_varint(at, end) + 1;
+            PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+            if (stores_actor(type))
+                actor = static_cast<PlayerId>(replay::get_varint(at, end));
+
+            if (type == EventType::TurnPassed)
+            {
+                game.pass_turn();
+                return true;
+            }
+            if (type >= EventType::ArrestUnblocked)
+                throw ReplayFormatException();
+            return SimEngine::apply(game, Action{static_cast<ActionKind>(type), actor,
+                                                 target == 0 ? kNoTarget : static_cast<PlayerId>(target - 1)});
+        }
+
+        // Step over the keyframe that starts at `at` (marker included) without decoding it
+        void skip_keyframe(const std::uint8_t *&at, const std::uint8_t *end)
+        {
+            get_byte(at, end); // Marker
+            std::uint64_t length = replay::get_varint(at, end);
+            if (length > static_cast<std::uint64_t>(end - at))
+                throw ReplayFormatException();
+            at += length;
+        }
+
+        // Step over records and keyframes up to and including the end marker
+        void skip_body(const std::uint8_t *&at, const std::uint8_t *end)
+        {
+            for (;;)
+            {
+                if (at == end)
+                    throw ReplayFormatException();
+                if (*at == replay::kKeyframeMarker)
+                {
+                    skip_keyframe(at, end);
+                    continue;
+                }
+                std::uint8_t byte = *at++;
+                if (byte == replay::kEndMarker)
+                    return;
+                if ((byte >> 4) == replay::kTargetEscape)
+                    replay::get_varint(at, end);
+                if (stores_actor(static_cast<EventType>(byte & 0x0F)))
+                    replay::get_varint(at, end);
+            }
+        }
+
+        // Decode the keyframe that starts at `at` (marker included)
+        void read_keyframe(const std::uint8_t *&at, const std::uint8_t *end, const GameState &base, GameState &state)
+        {
+            get_byte(at, end); // Marker
+            std::uint64_t length = replay::get_varint(at, end);
+            if (length > static_cast<std::uint64_t>(end - at))
+                throw ReplayFormatException();
+            const std::uint8_t *stop = at + length;
+            replay::get_state(at, stop, base, state);
+            if (at != stop)
+                throw ReplayFormatException();
+        }
+    }
+
+    /**
+     * @brief Reads an unsigned LEB128 varint.
+     * @param at Read position, advanced past the varint.
+     * @param end End of the data.
+     * @return std::uint64_t The decoded value.
+     * @throws ReplayFormatException if the data ends early or the varint is too long.
+     */
+    std::uint64_t replay::get_varint(const std::uint8_t *&at, const std::uint8_t *end)
+    {
+        std::uint64_t value;
+        if (!read_varint(at, end, value))
+            throw ReplayFormatException();
+        return value;
+    }
+
+    /**
+     * @brief Appends a state as the fields that differ from a base state.
+     *
+     * The rule fields are listed in a fixed order (see state_fields()) and coded
+     * as runs of (varint unchanged fields, varint changed fields, changed values
+     * as varints), so the encoding depends on neither the struct layout nor the
+     * compiler. Keyframes are taken against the state before the first move, so
+     * unchanged fields cost nothing.
+     *
+     * @param out Destination buffer.
+     * @param state The state to store.
+     * @param base The state both sides know (same seats).
+     */
+    void replay::put_state(std::vector<std::uint8_t> &out, const GameState &state, const GameState &base)
+    {
+        std::uint64_t now[kMaxStateFields], was[kMaxStateFields];
+        const std::size_t count = state_fields(state, now);
+        state_fields(base, was);
+        std::size_t at = 0;
+        while (at < count)
+        {
+            std::size_t same = 0;
+            while (at + same < count && now[at + same] == was[at + same])
+                ++same;
+            std::size_t changed = 0;
+            while (at + same + changed < count && now[at + same + changed] != was[at + same + changed])
+                ++changed;
+            write_varint(out, same);
+            write_varint(out, changed);
+            for (std::size_t i = at + same; i < at + same + changed; ++i)
+                write_varint(out, now[i]);
+            at += same + changed;
+        }
+    }
+
+    /**
+     * @brief Decodes a state written by put_state(); derived indexes and the hash are rebuilt.
+     * @param at Read position, advanced past the state.
+     * @param end End of the data.
+     * @param base The base state used when writing.
+     * @param state Receives the decoded state.
+     * @throws ReplayFormatException if the data is truncated or names a seat that does not exist.
+     */
+    void replay::get_state(const std::uint8_t *&at, const std::uint8_t *end, const GameState &base, GameState &state)
+    {
+        std::uint64_t values[kMaxStateFields];
+        const std::size_t count = state_fields(base, values);
+        std::size_t done = 0;
+        while (done < count)
+        {
+            std::uint64_t same = get_varint(at, end);
+            std::uint64_t changed = get_varint(at, end);
+            if (same > count - done || changed > count - done - same)
+                throw ReplayFormatException();
+            done += same;
+            for (std::uint64_t i = 0; i < changed; ++i)
+                values[done++] = get_varint(at, end);
+        }
+        copy_state(state, base);
+        set_state_fields(state, values);
+    }
+
+    /**
+     * @brief Lists the rule fields of a state in keyframe order: the turn counters,
+     *        tax and arrest records and the alive mask, then per seat its coins,
+     *        flags, turn counters, sanction, coup and tax records. Signed fields are
+     *        zigzag coded. Roles and derived indexes are left out.
+     * @param state The state.
+     * @param values Receives the fields (room for kMaxStateFields).
+     * @return std::size_t Number of fields written.
+     */
+    std::size_t replay::state_fields(const GameState &state, std::uint64_t *values)
+    {
+        std::uint64_t *out = values;
+        *out++ = state.global_turn_index;
+        *out++ = state.current_round;
+        *out++ = state.turn_index;
+        *out++ = state.last_arrested;
+        *out++ = state.latest_tax;
+        *out++ = state.tax_window ? 1 : 0;
+        *out++ = state.alive;
+        for (PlayerId i = 0; i < state.player_count; ++i)
+        {
+            const PlayerState &p = state.players[i];
+            const TaxRecord &tax = state.players[i].last_tax;
+            *out++ = zigzag(p.coins);
+            *out++ = p.flags;
+            *out++ = zigzag(p.extra_turns);
+            *out++ = zigzag(p.disable_arrest_turns);
+            *out++ = p.sanctioned_by;
+            *out++ = state.players[i].sanctions_by;
+            *out++ = state.players[i].couped_by;
+            *out++ = tax.turn;
+            *out++ = zigzag(tax.amount);
+            *out++ = tax.undoable ? 1 : 0;
+            *out++ = tax.previous;
+        }
+        return static_cast<std::size_t>(out - values);
+    }
+
+    /**
+     * @brief Inverse of state_fields(): stores the fields into a state whose seats
+     *        and roles are already set, then rebuilds the derived indexes and the hash.
+     * @param state The state to fill.
+     * @param values The fields, in keyframe order.
+     * @throws ReplayFormatException if a player field names a seat that does not exist.
+     */
+    void replay::set_state_fields(GameState &state, const std::uint64_t *values)
+    {
+        const std::size_t seats = state.player_count;
+        auto player = [seats](std::uint64_t value) { // A seat or kNoPlayer
+            if (value != kNoPlayer && value >= seats)
+                throw ReplayFormatException();
+            return static_cast<PlayerId>(value);
+        };
+        const std::uint64_t *in = values;
+        state.global_turn_index = static_cast<std::uint32_t>(*in++);
+        state.current_round = static_cast<std::uint32_t>(*in++);
+        state.turn_index = player(*in++);
+        state.last_arrested = player(*in++);
+        state.latest_tax = player(*in++);
+        state.tax_window = *in++ != 0;
+        state.alive = *in++;
+        if (state.turn_index == kNoPlayer)
+            throw ReplayFormatException();
+        state.abilities_used = 0;
+        for (std::size_t i = 0; i < seats; ++i)
+            state.players[i].coups_by = 0;
+        for (std::size_t i = 0; i < seats; ++i)
+        {
+            PlayerState &p = state.players[i];
+            TaxRecord &tax = state.players[i].last_tax;
+            p.coins = static_cast<std::int16_t>(unzigzag(*in++));
+            p.flags = static_cast<std::uint8_t>(*in++);
+            p.extra_turns = static_cast<std::int8_t>(unzigzag(*in++));
+            p.disable_arrest_turns = static_cast<std::int8_t>(unzigzag(*in++));
+            p.sanctioned_by = player(*in++);
+            state.players[i].sanctions_by = *in++;
+            state.players[i].couped_by = player(*in++);
+            tax.turn = static_cast<std::uint32_t>(*in++);
+            tax.amount = static_cast<std::int8_t>(unzigzag(*in++));
+            tax.undoable = *in++ != 0;
+            tax.previous = player(*in++);
+        }
+        for (std::size_t i = 0; i < seats; ++i) // Derived indexes are not stored
+        {
+            if (state.players[i].couped_by != kNoPlayer)
+                state.players[state.players[i].couped_by].coups_by |= player_bit(static_cast<PlayerId>(i));
+            if (state.players[i].has(PlayerFlag::AbilityUsed))
+                state.abilities_used |= player_bit(static_cast<PlayerId>(i));
+        }
+        state.hash = hash_state(state);
+    }
+
+    /**
+     * @brief Starts the writer thread.
+     * @param out The destination stream (should be opened in binary mode).
+     */
+    ReplayWriter::ReplayWriter(std::ostream &out) : out(out), thread(&ReplayWriter::loop, this) {}
+
+    /**
+     * @brief Writes every queued replay and stops the thread.
+     */
+    ReplayWriter::~ReplayWriter()
+    {
+        close();
+    }
+
+    /**
+     * @brief Queues a finished replay for writing.
+     *
+     * The caller's buffer is swapped with an empty one (a written buffer when one
+     * is available, so its capacity is reused). The lock is held only for the swap.
+     *
+     * @param replay The encoded replay; empty on return.
+     */
+    void ReplayWriter::submit(std::vector<std::uint8_t> &replay)
+    {
+        std::vector<std::uint8_t> empty;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!spare.empty())
+            {
+                empty.swap(spare.back());
+                spare.pop_back();
+            }
+            queue.emplace_back();
+            queue.back().swap(replay);
+        }
+        replay.swap(empty);
+        replay.clear();
+        ready.notify_one();
+    }
+
+    /**
+     * @brief Writes everything queued, flushes the stream and joins the thread. Safe to call twice.
+     */
+    void ReplayWriter::close()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+        ready.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    /**
+     * @brief Thread body: takes the whole queue at once, writes it outside the lock, recycles the buffers.
+     */
+    void ReplayWriter::loop()
+    {
+        std::vector<std::vector<std::uint8_t>> batch;
+        for (;;)
+        {
+            bool last;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                ready.wait(guard, [this] { return closing || !queue.empty(); });
+                batch.swap(queue);
+                last = closing && batch.empty();
+            }
+            if (last)
+                break;
+            for (std::vector<std::uint8_t> &replay : batch)
+            {
+                out.write(reinterpret_cast<const char *>(replay.data()), static_cast<std::streamsize>(replay.size()));
+                bytes += replay.size();
+                replays++;
+                replay.clear();
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            for (std::vector<std::uint8_t> &replay : batch)
+                spare.emplace_back().swap(replay);
+            batch.clear();
+        }
+        out.flush();
+    }
+
+    /**
+     * @brief Constructs a sink.
+     * @param writer Receives every finished replay; nullptr keeps the latest one in bytes().
+     * @param keyframe_every Records between keyframes; 0 writes none.
+     */
+    ReplaySink::ReplaySink(ReplayWriter *writer, std::uint64_t keyframe_every) : writer(writer), keyframe_every(keyframe_every) {}
+
+    /**
+     * @brief Writes the header of a new replay.
+     * @param game The game to record: players seated, no move played yet.
+     * @param seed Seed of the game's random engine.
+     * @param stream Random stream (game number) of the game.
+     */
+    void ReplaySink::begin(const Game &game, std::uint64_t seed, std::uint64_t stream)
+    {
+        this->game = &game;
+        records = 0;
+        keyframes.clear();
+        copy_state(initial, game.get_state());
+        buffer.clear();
+        buffer.push_back('C');
+        buffer.push_back('R');
+        buffer.push_back(replay::kVersion);
+        write_varint(buffer, seed);
+        write_varint(buffer, stream);
+        const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+        write_varint(buffer, players.size());
+        for (const std::shared_ptr<Player> &player : players)
+        {
+            buffer.push_back(static_cast<std::uint8_t>(player->role_id()));
+            write_varint(buffer, player->get_name().size());
+            buffer.insert(buffer.end(), player->get_name().begin(), player->get_name().end());
+        }
+    }
+
+    /**
+     * @brief Appends the record of a move; derived events and events outside begin()/finish() are ignored.
+     * @param event The event reported by the game.
+     */
+    void ReplaySink::on_event(const GameEvent &event)
+    {
+        if (!game || event.type == EventType::ArrestUnblocked || event.type == EventType::WinnerChanged)
+            return;
+        std::uint8_t target = event.target == kNoPlayer ? 0 : event.target + 1;
+        bool escaped = target >= replay::kTargetEscape;
+        buffer.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(event.type) |
+                                                   (escaped ? replay::kTargetEscape : target) << 4));
+        if (escaped)
+            write_varint(buffer, event.target);
+        if (stores_actor(event.type))
+            write_varint(buffer, event.actor);
+        records++;
+    }
+
+    /**
+     * @brief Writes a keyframe of the current state if keyframe_every records have
+     *        passed since the last one. Call it only between moves.
+     */
+    void ReplaySink::checkpoint()
+    {
+        std::uint64_t last = keyframes.empty() ? 0 : keyframes.back().record;
+        if (!game || keyframe_every == 0 || records - last < keyframe_every)
+            return;
+        keyframes.push_back(ReplayKeyframe{records, buffer.size()});
+        buffer.push_back(replay::kKeyframeMarker);
+        std::size_t length_at = buffer.size();
+        buffer.push_back(0); // Length placeholder, usually one byte
+        replay::put_state(buffer, game->get_state(), initial);
+        std::size_t length = buffer.size() - length_at - 1;
+        if (length < 0x80)
+        {
+            buffer[length_at] = static_cast<std::uint8_t>(length);
+            return;
+        }
+        std::vector<std::uint8_t> prefix; // Rare: the state needs a longer length field
+        write_varint(prefix, length);
+        buffer.erase(buffer.begin() + static_cast<std::ptrdiff_t>(length_at));
+        buffer.insert(buffer.begin() + static_cast<std::ptrdiff_t>(length_at), prefix.begin(), prefix.end());
+    }
+
+    /**
+     * @brief Writes the footer and the keyframe index and hands the replay to the writer (if any).
+     */
+    void ReplaySink::finish()
+    {
+        if (!game)
+            return;
+        std::size_t footer = buffer.size();
+        buffer.push_back(replay::kEndMarker);
+        write_varint(buffer, records);
+        std::uint64_t hash = game->get_hash();
+        for (int i = 0; i < 8; ++i)
+            buffer.push_back(static_cast<std::uint8_t>(hash >> (8 * i)));
+        write_varint(buffer, keyframes.size());
+        ReplayKeyframe previous;
+        for (const ReplayKeyframe &keyframe : keyframes)
+        {
+            write_varint(buffer, keyframe.record - previous.record);
+            write_varint(buffer, keyframe.offset - previous.offset);
+            previous = keyframe;
+        }
+        std::uint32_t length = static_cast<std::uint32_t>(buffer.size() - footer);
+        for (int i = 0; i < 4; ++i)
+            buffer.push_back(static_cast<std::uint8_t>(length >> (8 * i)));
+        game = nullptr;
+        if (writer)
+            writer->submit(buffer);
+    }
+
+    /**
+     * @brief Constructs a reader over a log held in memory.
+     * @param data First byte of the log.
+     * @param size Length of the log in bytes.
+     */
+    ReplayReader::ReplayReader(const std::uint8_t *data, std::size_t size) : at(data), end(data + size) {}
+
+    /**
+     * @brief Reads the next replay, seats its players in game and re-executes every move.
+     *
+     * Turn actions are played by the current player, reactions by their stored
+     * actor, all through SimEngine::apply(), so the rules check every move again.
+     * Every keyframe, the move count and the final position hash must match the
+     * replayed game. Keyframes of older versions are stepped over unchecked.
+     *
+     * @param game An empty game to replay into.
+     * @return ReplayInfo The header, move count and verified hash.
+     * @throws ReplayFormatException if the data is truncated or malformed.
+     * @throws ReplayMismatchException if a move is refused or the state differs.
+     */
+    ReplayInfo ReplayReader::next(Game &game)
+    {
+        const std::uint8_t *start = at;
+        ReplayInfo info;
+        read_header(at, end, info);
+        seat(game, info);
+        const GameState base = game.get_state();
+
+        std::uint64_t keyframes = 0;
+        for (;;)
+        {
+            if (at == end)
+                throw ReplayFormatException();
+            if (*at == replay::kEndMarker)
+                break;
+            if (*at == replay::kKeyframeMarker)
+            {
+                keyframes++;
+                if (info.version != replay::kVersion)
+                {
+                    skip_keyframe(at, end); // Another GameState layout
+                    continue;
+                }
+                GameState state;
+                read_keyframe(at, end, base, state);
+                if (state.hash != game.get_hash())
+                    throw ReplayMismatchException(info.records, "keyframe differs");
+                continue;
+            }
+            if (!play_record(at, end, game))
+                throw ReplayMismatchException(info.records, std::string(action_name(static_cast<ActionKind>(*(at - 1) & 0x0F))) + " was refused");
+            info.records++;
+        }
+
+        get_byte(at, end); // End marker
+        std::uint64_t records = replay::get_varint(at, end);
+        info.hash = get_fixed64(at, end);
+        if (records != info.records)
+            throw ReplayMismatchException(info.records, "footer counts " + std::to_string(records) + " records");
+        if (info.hash != game.get_hash())
+            throw ReplayMismatchException(info.records, "final state differs");
+        if (info.version < replay::kIndexVersion)
+        {
+            info.bytes = static_cast<std::size_t>(at - start);
+            return info;
+        }
+        if (replay::get_varint(at, end) != keyframes)
+            throw ReplayFormatException();
+        for (std::uint64_t i = 0; i < 2 * keyframes; ++i)
+            replay::get_varint(at, end);
+        for (int i = 0; i < 4; ++i)
+            get_byte(at, end);
+        info.bytes = static_cast<std::size_t>(at - start);
+        return info;
+    }
+
+    /**
+     * @brief Steps over the next replay by walking its records, without playing them.
+     * @return ReplaySpan Where the replay is (hand it to a ReplaySeeker for random access).
+     * @throws ReplayFormatException if the data is truncated or malformed.
+     */
+    ReplaySpan ReplayReader::skip()
+    {
+        const std::uint8_t *start = at;
+        ReplayInfo info;
+        read_header(at, end, info);
+        skip_body(at, end);
+        replay::get_varint(at, end);
+        get_fixed64(at, end);
+        if (info.version < replay::kIndexVersion)
+            return ReplaySpan{start, static_cast<std::size_t>(at - start)};
+        std::uint64_t keyframes = replay::get_varint(at, end);
+        for (std::uint64_t i = 0; i < 2 * keyframes; ++i)
+            replay::get_varint(at, end);
+        for (int i = 0; i < 4; ++i)
+            get_byte(at, end);
+        return ReplaySpan{start, static_cast<std::size_t>(at - start)};
+    }
+
+    /**
+     * @brief Reads the header of one replay and its index from the end of the replay
+     *        (a version 1 replay, which has no index, is walked to its footer).
+     * @param span The replay (for instance from ReplayReader::skip() or ReplaySink::bytes()).
+     * @throws ReplayFormatException if the replay is malformed.
+     */
+    ReplaySeeker::ReplaySeeker(const ReplaySpan &span) : span(span)
+    {
+        const std::uint8_t *at = span.data;
+        const std::uint8_t *end = span.data + span.size;
+        read_header(at, end, header);
+        body = static_cast<std::size_t>(at - span.data);
+        header.bytes = span.size;
+
+        if (header.version < replay::kIndexVersion) // No index: walk to the footer
+        {
+            skip_body(at, end);
+            header.records = replay::get_varint(at, end);
+            header.hash = get_fixed64(at, end);
+        }
+        else
+            read_index(at, end);
+
+        Game fresh;
+        seat(fresh, header);
+        copy_state(base, fresh.get_state());
+    }
+
+    /**
+     * @brief Reads the footer and the keyframe index from the end of the replay.
+     *
+     * Keyframes of older versions hold another GameState layout, so they are not
+     * kept: seeking then replays from the start.
+     *
+     * @param at Scratch read position.
+     * @param end End of the replay.
+     * @throws ReplayFormatException if the footer or index is malformed.
+     */
+    void ReplaySeeker::read_index(const std::uint8_t *&at, const std::uint8_t *end)
+    {
+        if (span.size < body + 4)
+            throw ReplayFormatException();
+        std::uint32_t length = 0;
+        for (int i = 0; i < 4; ++i)
+            length |= static_cast<std::uint32_t>(span.data[span.size - 4 + i]) << (8 * i);
+        if (length > span.size - body - 4)
+            throw ReplayFormatException();
+        at = end - 4 - length;
+        if (get_byte(at, end) != replay::kEndMarker)
+            throw ReplayFormatException();
+        header.records = replay::get_varint(at, end);
+        header.hash = get_fixed64(at, end);
+        std::uint64_t count = replay::get_varint(at, end);
+        ReplayKeyframe keyframe;
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            keyframe.record += replay::get_varint(at, end);
+            keyframe.offset += static_cast<std::size_t>(replay::get_varint(at, end));
+            if (keyframe.record > header.records || keyframe.offset < body || keyframe.offset >= span.size ||
+                span.data[keyframe.offset] != replay::kKeyframeMarker)
+                throw ReplayFormatException();
+            if (header.version == replay::kVersion)
+                keyframes.push_back(keyframe);
+        }
+    }
+
+    /**
+     * @brief Puts a game right before move `record` of the replay.
+     *
+     * The nearest keyframe at or before the move is found by binary search and
+     * restored, then at most keyframe_every moves are replayed from it.
+     *
+     * @param game An empty game, or one already used with this seeker.
+     * @param record Moves to have played (0 = start, info().records = end of game).
+     * @return std::uint64_t Moves replayed after the keyframe.
+     * @throws std::out_of_range if record is past the end of the game.
+     * @throws ReplayMismatchException if a move is refused.
+     */
+    std::uint64_t ReplaySeeker::seek(Game &game, std::uint64_t record) const
+    {
+        if (record > header.records)
+            throw std::out_of_range("record is past the end of the replay");
+        const std::uint8_t *end = span.data + span.size;
+        if (game.get_all_players().empty())
+            seat(game, header);
+
+        auto after = std::upper_bound(keyframes.begin(), keyframes.end(), record,
+                                      [](std::uint64_t value, const ReplayKeyframe &keyframe) { return value < keyframe.record; });
+        const std::uint8_t *at = span.data + body;
+        std::uint64_t played = 0;
+        if (after == keyframes.begin())
+        {
+            game.set_state(base);
+        }
+        else
+        {
+            const ReplayKeyframe &keyframe = *(after - 1);
+            at = span.data + keyframe.offset;
+            GameState state;
+            read_keyframe(at, end, base, state);
+            game.set_state(state);
+            played = keyframe.record;
+        }
+        game.clear_history();
+
+        std::uint64_t replayed = 0;
+        while (played < record)
+        {
+            if (at == end || *at == replay::kEndMarker)
+                throw ReplayFormatException();
+            if (*at == replay::kKeyframeMarker)
+            {
+                skip_keyframe(at, end);
+                continue;
+            }
+            if (!play_record(at, end, game))
+                throw ReplayMismatchException(played, "move was refused");
+            played++;
+            replayed++;
+        }
+        return replayed;
+    }
+
+}
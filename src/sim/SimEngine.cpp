@@ -0,0 +1,337 @@
+// Author: noapatito123@gmail.com
+#include "SimEngine.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Spy.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace coup
+{
+
+    namespace
+    {
+        constexpr int kAttemptsPerTurn = 8; // Rejected moves tolerated before falling back
+    }
+
+    // One batch thread: its strategy per seat, the table of its previous game and its replay sink
+    struct SimEngine::Worker
+    {
+        std::vector<std::shared_ptr<Strategy>> seats; // Strategy per seat (clones on pool workers)
+        std::unique_ptr<Game> game;                   // Table of the previous game (nullptr before the first)
+        std::vector<RoleId> roles;                    // Roles at that table
+        GameState initial;                            // That table before the first move
+        ReplaySink sink;                              // Records the games when the engine has a recorder
+
+        Worker(std::vector<std::shared_ptr<Strategy>> seats, ReplayWriter *writer, std::uint64_t keyframe_every)
+            : seats(std::move(seats)), sink(writer, keyframe_every) {}
+    };
+
+    /**
+     * @brief Constructs an engine with a RandomStrategy in every seat.
+     * @param config Batch settings.
+     * @throws std::invalid_argument if the roster names an unknown role.
+     */
+    SimEngine::SimEngine(const SimConfig &config) : config(config)
+    {
+        std::size_t seat_count = config.roles.empty() ? config.players : config.roles.size();
+        for (std::size_t i = 0; i < seat_count; ++i)
+        {
+            strategies.push_back(std::make_shared<RandomStrategy>());
+            names.push_back("P" + std::to_string(i));
+        }
+        for (const std::string &role : config.roles)
+            roster.push_back(role_from_name(role));
+    }
+
+    /**
+     * @brief Destructor (Worker is only complete in this file).
+     */
+    SimEngine::~SimEngine() {}
+
+    /**
+     * @brief Replaces the strategy of one seat.
+     * @param seat Seat index.
+     * @param strategy The new strategy.
+     * @throws std::out_of_range if the seat does not exist.
+     */
+    void SimEngine::set_strategy(std::size_t seat, const std::shared_ptr<Strategy> &strategy)
+    {
+        strategies.at(seat) = strategy;
+        workers.clear(); // Their clones are stale
+    }
+
+    /**
+     * @brief Records every game of later run() calls as a replay.
+     * @param writer Receives the replays (must outlive the runs); nullptr stops recording.
+     * @param keyframe_every Moves between keyframes (0 = none).
+     */
+    void SimEngine::record_to(ReplayWriter *writer, std::uint64_t keyframe_every)
+    {
+        recorder = writer;
+        this->keyframe_every = keyframe_every;
+        workers.clear(); // Their sinks point at the old writer
+    }
+
+    /**
+     * @brief Runs an action through the non-throwing Player API.
+     * @param game The game to act on.
+     * @param action The action to perform.
+     * @return true if the rules accepted the action.
+     */
+    bool SimEngine::apply(Game &game, const Action &action)
+    {
+        const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+        if (action.actor >= players.size())
+            return false;
+        if (is_targeted(action.kind) && action.target >= players.size())
+            return false;
+
+        Player *actor = players[action.actor].get();
+        switch (action.kind)
+        {
+        case ActionKind::Gather:
+            return actor->try_gather() == ActionStatus::Ok;
+        case ActionKind::Tax:
+            return actor->try_tax() == ActionStatus::Ok;
+        case ActionKind::Bribe:
+            return actor->try_bribe() == ActionStatus::Ok;
+        case ActionKind::Arrest:
+            return actor->try_arrest(action.target) == ActionStatus::Ok;
+        case ActionKind::Sanction:
+            return actor->try_sanction(action.target) == ActionStatus::Ok;
+        case ActionKind::Coup:
+            return actor->try_coup(action.target) == ActionStatus::Ok;
+        case ActionKind::Invest:
+            return actor->role_id() == RoleId::Baron &&
+                   static_cast<Baron *>(actor)->try_invest() == ActionStatus::Ok;
+        case ActionKind::UndoTax:
+            return actor->role_id() == RoleId::Governor &&
+                   static_cast<Governor *>(actor)->try_undo_tax() == ActionStatus::Ok;
+        case ActionKind::UndoBribe:
+            return actor->role_id() == RoleId::Judge &&
+                   static_cast<Judge *>(actor)->try_undo_bribe(action.target) == ActionStatus::Ok;
+        case ActionKind::UndoCoup:
+            return actor->role_id() == RoleId::General &&
+                   static_cast<General *>(actor)->try_undo_coup(action.target) == ActionStatus::Ok;
+        case ActionKind::PeekAndDisable:
+            return actor->role_id() == RoleId::Spy &&
+                   static_cast<Spy *>(actor)->try_peek_and_disable(action.target) == ActionStatus::Ok;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief Draws the roles of the next game (or copies the fixed roster).
+     * @param rng Random engine of the game.
+     * @param roles Receives one role per seat.
+     */
+    void SimEngine::draw_roles(SimRng &rng, RoleId roles[]) const
+    {
+        for (std::size_t i = 0; i < strategies.size(); ++i)
+            roles[i] = roster.empty() ? static_cast<RoleId>(rng() % kRoleCount) : roster[i];
+    }
+
+    /**
+     * @brief Plays one complete game from an empty table to a winner (or the turn cap).
+     * @param rng Random engine for roles and strategies.
+     * @return GameResult Winner, turns and accepted actions.
+     */
+    GameResult SimEngine::play_game(SimRng &rng)
+    {
+        RoleId roles[kMaxPlayers];
+        draw_roles(rng, roles);
+        Game game(strategies.size());
+        for (std::size_t i = 0; i < strategies.size(); ++i)
+            game.add_player(create_player(game, roles[i], names[i]));
+        return play(game, strategies, rng);
+    }
+
+    /**
+     * @brief Plays game number index of the batch on a worker.
+     *
+     * The game draws from its own stream (game_stream()), so its result does not
+     * depend on which worker runs it. The worker's table is reused when
+     * the roles match the previous game: restoring the initial state is enough.
+     * With a recorder the game is written as a replay of (seed, index).
+     *
+     * @param worker The worker running the game.
+     * @param index Game number.
+     * @return GameResult Winner, turns and accepted actions.
+     */
+    GameResult SimEngine::play_indexed(Worker &worker, std::size_t index) const
+    {
+        SimRng rng = game_stream(config.seed, index);
+        RoleId roles[kMaxPlayers];
+        draw_roles(rng, roles);
+
+        if (worker.game && std::equal(worker.roles.begin(), worker.roles.end(), roles))
+        {
+            worker.game->set_state(worker.initial);
+            worker.game->clear_history();
+        }
+        else
+        {
+            worker.game.reset(new Game(strategies.size()));
+            worker.roles.assign(roles, roles + strategies.size());
+            for (std::size_t i = 0; i < strategies.size(); ++i)
+                worker.game->add_player(create_player(*worker.game, roles[i], names[i]));
+            copy_state(worker.initial, worker.game->get_state());
+        }
+        if (!recorder)
+        {
+            worker.game->set_event_sink(nullptr);
+            return play(*worker.game, worker.seats, rng);
+        }
+        worker.game->set_event_sink(&worker.sink);
+        worker.sink.begin(*worker.game, config.seed, index);
+        GameResult result = play(*worker.game, worker.seats, rng, &worker.sink);
+        worker.sink.finish();
+        return result;
+    }
+
+    /**
+     * @brief Plays a seated game until one player is left (or the turn cap).
+     *
+     * Each turn the current seat's strategy proposes moves until the rules accept one.
+     * If nothing is accepted the seat falls back to gather, and if even that fails
+     * (e.g. a sanctioned player with no coins) the turn is passed.
+     * After every accepted move the other seats get a chance to react out of turn.
+     *
+     * @param game The game, with one player per seat.
+     * @param seats Strategy per seat.
+     * @param rng Random engine for strategies.
+     * @param recording Sink recording the game, given a keyframe chance between turns (nullptr if none).
+     * @return GameResult Winner, turns and accepted actions.
+     */
+    GameResult SimEngine::play(Game &game, const std::vector<std::shared_ptr<Strategy>> &seats, SimRng &rng,
+                               ReplaySink *recording) const
+    {
+        GameResult result;
+        const std::vector<std::shared_ptr<Player>> &players = game.get_all_players();
+        while (game.get_active_players_count() > 1 && result.turns < config.max_turns)
+        {
+            if (recording)
+                recording->checkpoint();
+            PlayerId current = static_cast<PlayerId>(game.get_turn_index());
+            Action played{ActionKind::Gather, current, kNoTarget};
+            bool accepted = false;
+            for (int attempt = 0; attempt < kAttemptsPerTurn && !accepted; ++attempt)
+            {
+                played = seats[current]->choose_action(game, current, rng);
+                played.actor = current;
+                accepted = apply(game, played);
+            }
+            if (!accepted)
+            {
+                played = {ActionKind::Gather, current, kNoTarget};
+                accepted = apply(game, played);
+            }
+            result.turns++;
+            if (!accepted)
+            {
+                game.pass_turn(); // No legal move
+                continue;
+            }
+            result.actions++;
+
+            for (std::size_t seat = 0; seat < players.size(); ++seat)
+            {
+                bool couped_self = played.kind == ActionKind::Coup && played.target == seat;
+                if (seat == current || (players[seat]->is_eliminated() && !couped_self))
+                    continue;
+                Action reaction;
+                PlayerId self = static_cast<PlayerId>(seat);
+                if (seats[seat]->choose_reaction(game, self, played, rng, reaction))
+                {
+                    reaction.actor = self;
+                    if (apply(game, reaction))
+                        result.actions++;
+                }
+            }
+        }
+
+        if (game.is_game_over())
+            result.winner = game.get_winner();
+        return result;
+    }
+
+    /**
+     * @brief Plays the configured number of games and measures throughput.
+     *
+     * Game number g draws from game_stream(seed, g), so any single game of a batch
+     * can be replayed alone. The seat strategies themselves are used (not clones).
+     *
+     * @return SimStats Aggregated results and timings.
+     */
+    SimStats SimEngine::run()
+    {
+        SimStats stats;
+        stats.wins.assign(strategies.size(), 0);
+        Worker serial(strategies, recorder, keyframe_every);
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t g = 0; g < config.games; ++g)
+        {
+            GameResult result = play_indexed(serial, g);
+            stats.games++;
+            stats.actions += result.actions;
+            if (result.winner < 0)
+                stats.draws++;
+            else
+                stats.wins[result.winner]++;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats.seconds = elapsed.count();
+        return stats;
+    }
+
+    /**
+     * @brief Plays the configured number of games on a thread pool.
+     *
+     * Every worker plays with its own clones of the seat strategies (made on the
+     * first batch and kept) and reuses its table between games. Results are stored
+     * by game number and summed in that order, so the stats are the same for any
+     * number of workers, and the same as run().
+     *
+     * @param pool The pool to run on.
+     * @return SimStats Aggregated results and timings.
+     */
+    SimStats SimEngine::run(WorkStealingPool &pool)
+    {
+        while (workers.size() < pool.size())
+        {
+            std::vector<std::shared_ptr<Strategy>> clones;
+            for (const std::shared_ptr<Strategy> &strategy : strategies)
+                clones.push_back(strategy->clone());
+            workers.emplace_back(new Worker(std::move(clones), recorder, keyframe_every));
+        }
+
+        SimStats stats;
+        stats.wins.assign(strategies.size(), 0);
+        std::vector<GameResult> results(config.games);
+
+        auto start = std::chrono::steady_clock::now();
+        pool.run(config.games, [&](std::size_t worker, std::size_t index) {
+            results[index] = play_indexed(*workers[worker], index);
+        });
+        for (const GameResult &result : results)
+        {
+            stats.games++;
+            stats.actions += result.actions;
+            if (result.winner < 0)
+                stats.draws++;
+            else
+                stats.wins[result.winner]++;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats.seconds = elapsed.count();
+        return stats;
+    }
+
+}
@@ -0,0 +1,150 @@
+// Author: noapatito123@gmail.com
+#include "Strategy.hpp"
+#include "Player.hpp"
+
+namespace coup
+{
+
+    namespace
+    {
+        // Picks a random living opponent of `self`, or kNoTarget if none is left
+        PlayerId random_opponent(const Game &game, PlayerId self, SimRng &rng)
+        {
+            PlayerMask opponents = game.get_alive_mask() & ~player_bit(self);
+            int count = mask_count(opponents);
+            if (count == 0)
+                return kNoTarget;
+            for (std::uint64_t skip = rng() % count; skip > 0; --skip)
+                opponents &= opponents - 1; // drop the lowest opponent
+            return mask_first(opponents);
+        }
+
+        // Picks the living opponent of `self` with the most coins
+        PlayerId richest_opponent(const Game &game, PlayerId self)
+        {
+            const GameState &state = game.get_state();
+            PlayerId best = kNoTarget;
+            for (PlayerMask opponents = game.get_alive_mask() & ~player_bit(self); opponents; opponents &= opponents - 1)
+            {
+                PlayerId i = mask_first(opponents);
+                if (best == kNoTarget || state.players[i].coins > state.players[best].coins)
+                    best = i;
+            }
+            return best;
+        }
+    }
+
+    /**
+     * @brief Default reaction policy: never react.
+     * @return false always.
+     */
+    bool Strategy::choose_reaction(const Game &, PlayerId, const Action &, SimRng &, Action &)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Picks a random move among those the player can plausibly afford.
+     *
+     * Only public information (own coins and flags) is used to filter the moves;
+     * anything that is still illegal is rejected by the rules and retried by the engine.
+     */
+    Action RandomStrategy::choose_action(const Game &game, PlayerId self, SimRng &rng)
+    {
+        const Player &me = *game.get_all_players()[self];
+        int coins = me.get_coins();
+        PlayerId target = random_opponent(game, self, rng);
+
+        if (me.must_coup() || coins >= 10)
+            return {ActionKind::Coup, self, target};
+
+        Action options[7];
+        std::size_t count = 0;
+        if (!me.is_sanctioned())
+        {
+            options[count++] = {ActionKind::Gather, self, kNoTarget};
+            options[count++] = {ActionKind::Tax, self, kNoTarget};
+        }
+        if (coins >= 4)
+            options[count++] = {ActionKind::Bribe, self, kNoTarget};
+        if (coins >= 3 && me.role_id() == RoleId::Baron)
+            options[count++] = {ActionKind::Invest, self, kNoTarget};
+        if (!me.is_disable_to_arrest())
+            options[count++] = {ActionKind::Arrest, self, target};
+        if (coins >= 3)
+            options[count++] = {ActionKind::Sanction, self, target};
+        if (coins >= 7)
+            options[count++] = {ActionKind::Coup, self, target};
+
+        if (count == 0)
+            return {ActionKind::Gather, self, kNoTarget};
+        return options[rng() % count];
+    }
+
+    /**
+     * @brief Uses the player's role ability with a fixed probability when it applies.
+     */
+    bool RandomStrategy::choose_reaction(const Game &game, PlayerId self, const Action &last, SimRng &rng, Action &out)
+    {
+        if (last.actor == self || rng.uniform() >= reaction_chance)
+            return false;
+
+        const Player &me = *game.get_all_players()[self];
+        RoleId role = me.role_id();
+        if (role == RoleId::Governor && last.kind == ActionKind::Tax)
+            out = {ActionKind::UndoTax, self, kNoTarget};
+        else if (role == RoleId::Judge && last.kind == ActionKind::Bribe)
+            out = {ActionKind::UndoBribe, self, last.actor};
+        else if (role == RoleId::General && last.kind == ActionKind::Coup && me.get_coins() >= 5)
+            out = {ActionKind::UndoCoup, self, last.target};
+        else if (role == RoleId::Spy)
+            out = {ActionKind::PeekAndDisable, self, random_opponent(game, self, rng)};
+        else
+            return false;
+        return out.target != kNoTarget || out.kind == ActionKind::UndoTax;
+    }
+
+    /**
+     * @brief Coups the richest opponent when affordable, otherwise maximizes coin income.
+     */
+    Action GreedyStrategy::choose_action(const Game &game, PlayerId self, SimRng &)
+    {
+        const Player &me = *game.get_all_players()[self];
+        int coins = me.get_coins();
+        PlayerId target = richest_opponent(game, self);
+
+        if (coins >= 7)
+            return {ActionKind::Coup, self, target};
+        if (coins >= 3 && me.role_id() == RoleId::Baron)
+            return {ActionKind::Invest, self, kNoTarget};
+        if (!me.is_sanctioned())
+            return {ActionKind::Tax, self, kNoTarget};
+        if (!me.is_disable_to_arrest())
+            return {ActionKind::Arrest, self, target};
+        return {ActionKind::Gather, self, kNoTarget};
+    }
+
+    /**
+     * @brief Always uses a role ability when it hurts an opponent or saves itself.
+     */
+    bool GreedyStrategy::choose_reaction(const Game &game, PlayerId self, const Action &last, SimRng &, Action &out)
+    {
+        if (last.actor == self)
+            return false;
+
+        const Player &me = *game.get_all_players()[self];
+        RoleId role = me.role_id();
+        if (role == RoleId::Governor && last.kind == ActionKind::Tax)
+            out = {ActionKind::UndoTax, self, kNoTarget};
+        else if (role == RoleId::Judge && last.kind == ActionKind::Bribe)
+            out = {ActionKind::UndoBribe, self, last.actor};
+        else if (role == RoleId::General && last.kind == ActionKind::Coup && me.get_coins() >= 5)
+            out = {ActionKind::UndoCoup, self, last.target};
+        else if (role == RoleId::Spy && last.kind == ActionKind::Arrest)
+            out = {ActionKind::PeekAndDisable, self, last.actor};
+        else
+            return false;
+        return true;
+    }
+
+}
@@ -0,0 +1,185 @@
+// Author: noapatito123@gmail.com
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace coup
+{
+
+    /**
+     * @brief Starts the helper threads.
+     * @param threads Worker count including the caller; 0 means one per hardware thread.
+     */
+    WorkStealingPool::WorkStealingPool(std::size_t threads)
+        : workers(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+        deques.reset(new Deque[workers]);
+        for (std::size_t w = 1; w < workers; ++w)
+            helpers.emplace_back(&WorkStealingPool::helper_loop, this, w);
+    }
+
+    /**
+     * @brief Stops and joins the helper threads.
+     */
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(control);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &helper : helpers)
+            helper.join();
+    }
+
+    /**
+     * @brief Takes the newest task from a worker's own deque.
+     * @param worker The worker.
+     * @param task Receives the task number.
+     * @return true if a task was taken.
+     */
+    bool WorkStealingPool::pop(std::size_t worker, std::size_t &task)
+    {
+        Deque &own = deques[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.begin == own.end)
+            return false;
+        task = --own.end;
+        return true;
+    }
+
+    /**
+     * @brief Steals the older half of the first non-empty deque after the worker's own.
+     *
+     * The first stolen task is returned to run at once and the rest becomes the
+     * worker's own deque (which is empty whenever a worker steals).
+     *
+     * @param worker The thief.
+     * @param task Receives the task to run.
+     * @return true if anything was stolen.
+     */
+    bool WorkStealingPool::steal(std::size_t worker, std::size_t &task)
+    {
+        for (std::size_t offset = 1; offset < workers; ++offset)
+        {
+            Deque &victim = deques[(worker + offset) % workers];
+            std::size_t first, last;
+            {
+                std::lock_guard<std::mutex> guard(victim.lock);
+                std::size_t count = victim.end - victim.begin;
+                if (count == 0)
+                    continue;
+                first = victim.begin;
+                last = first + (count + 1) / 2;
+                victim.begin = last;
+            }
+            steal_count.fetch_add(1, std::memory_order_relaxed);
+            task = first;
+            Deque &own = deques[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            own.begin = first + 1;
+            own.end = last;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Runs tasks, own first and then stolen ones, until every task of the batch is done.
+     *
+     * Tasks are taken off a deque before they run, so a worker may find every deque
+     * empty while others are still busy; it then yields until the batch ends.
+     *
+     * @param worker The worker running the loop.
+     */
+    void WorkStealingPool::drain(std::size_t worker)
+    {
+        std::size_t task;
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!pop(worker, task) && !steal(worker, task))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            try
+            {
+                (*body)(worker, task);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(control);
+                if (!failure)
+                    failure = std::current_exception();
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    /**
+     * @brief Thread body of a helper: waits for a batch, drains it, reports back.
+     * @param worker The helper's worker number.
+     */
+    void WorkStealingPool::helper_loop(std::size_t worker)
+    {
+        std::size_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> guard(control);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+            drain(worker);
+            {
+                std::lock_guard<std::mutex> guard(control);
+                --busy;
+            }
+            done.notify_one();
+        }
+    }
+
+    /**
+     * @brief Runs tasks 0..tasks-1 on every worker and waits until all have finished.
+     *
+     * Worker w starts with the w-th contiguous slice of the task numbers. Results
+     * should be written to a slot per task number, which keeps their order
+     * independent of scheduling.
+     *
+     * @param tasks Number of tasks.
+     * @param task_body Called once per task, from any worker.
+     * @throws Rethrows the first exception thrown by a task, after the batch has finished.
+     */
+    void WorkStealingPool::run(std::size_t tasks, const Body &task_body)
+    {
+        if (tasks == 0)
+            return;
+        for (std::size_t w = 0; w < workers; ++w)
+        {
+            std::lock_guard<std::mutex> guard(deques[w].lock);
+            deques[w].begin = tasks * w / workers;
+            deques[w].end = tasks * (w + 1) / workers;
+        }
+        body = &task_body;
+        failure = nullptr;
+        steal_count.store(0, std::memory_order_relaxed);
+        remaining.store(tasks, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(control);
+            busy = helpers.size();
+            ++generation;
+        }
+        wake.notify_all();
+
+        drain(0);
+        {
+            std::unique_lock<std::mutex> guard(control);
+            done.wait(guard, [&] { return busy == 0; });
+        }
+        body = nullptr;
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+}
@@ -0,0 +1,193 @@
+// Author: noapatito123@gmail.com
+#include "TranspositionTable.hpp"
+#include <stdexcept>
+
+namespace coup
+{
+
+    namespace
+    {
+        constexpr std::uint8_t kGenerationMask = 0x3F; // Generations use 6 bits, 0 is reserved for empty entries
+
+        // Packs data and generation into one word: value | depth | bound:2 gen:6 | kind | actor | target
+        std::uint64_t pack(const TTData &data, std::uint8_t generation)
+        {
+            return static_cast<std::uint64_t>(static_cast<std::uint16_t>(data.value)) |
+                   static_cast<std::uint64_t>(data.depth) << 16 |
+                   static_cast<std::uint64_t>(static_cast<std::uint8_t>(data.bound) | generation << 2) << 24 |
+                   static_cast<std::uint64_t>(data.best.kind) << 32 |
+                   static_cast<std::uint64_t>(data.best.actor) << 40 |
+                   static_cast<std::uint64_t>(data.best.target) << 48;
+        }
+
+        // Inverse of pack (the generation is dropped)
+        TTData unpack(std::uint64_t word)
+        {
+            TTData data;
+            data.value = static_cast<std::int16_t>(word & 0xFFFF);
+            data.depth = static_cast<std::uint8_t>(word >> 16);
+            data.bound = static_cast<TTBound>((word >> 24) & 0x3);
+            data.best.kind = static_cast<ActionKind>(word >> 32);
+            data.best.actor = static_cast<PlayerId>(word >> 40);
+            data.best.target = static_cast<PlayerId>(word >> 48);
+            return data;
+        }
+
+        std::uint8_t generation_of(std::uint64_t word) { return (word >> 26) & kGenerationMask; } // Generation of a packed word
+        std::uint8_t depth_of(std::uint64_t word) { return static_cast<std::uint8_t>(word >> 16); } // Depth of a packed word
+    }
+
+    /**
+     * @brief Allocates the table.
+     * @param megabytes Memory budget; the table uses the largest power-of-two
+     *        number of 64-byte clusters that fits in it.
+     * @throws std::invalid_argument if the budget cannot hold a single cluster.
+     */
+    TranspositionTable::TranspositionTable(std::size_t megabytes)
+    {
+        std::size_t budget = megabytes * 1024 * 1024 / sizeof(Cluster);
+        if (budget == 0)
+            throw std::invalid_argument("transposition table needs at least 1 MB");
+        std::size_t count = 1;
+        while (count * 2 <= budget)
+            count *= 2;
+        clusters = std::vector<Cluster>(count);
+        mask = count - 1;
+    }
+
+    /**
+     * @brief Picks the counter stripe of the calling thread (assigned round-robin on first use).
+     * @return Counters& The stripe, so threads rarely share a cache line.
+     */
+    TranspositionTable::Counters &TranspositionTable::local_counters() const
+    {
+        static std::atomic<std::size_t> next_stripe{0};
+        thread_local std::size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % kCounterStripes;
+        return counters[stripe];
+    }
+
+    /**
+     * @brief Looks a position up.
+     * @param key 64-bit digest of the position (e.g. Game::get_hash()).
+     * @param out Receives the stored data on a hit.
+     * @return true if an intact entry for key was found.
+     */
+    bool TranspositionTable::probe(std::uint64_t key, TTData &out) const
+    {
+        const Cluster &cluster = clusters[key & mask];
+        for (const Entry &entry : cluster.entries)
+        {
+            std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            if (data != 0 && (entry.check.load(std::memory_order_relaxed) ^ data) == key)
+            {
+                out = unpack(data);
+                local_counters().hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        local_counters().misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Stores a search result.
+     *
+     * An entry for the same position is overwritten. Otherwise an empty entry
+     * of the cluster is used, or else the one with the lowest depth after an
+     * aging penalty for each search generation it is old.
+     *
+     * @param key 64-bit digest of the position.
+     * @param data The result to keep.
+     */
+    void TranspositionTable::store(std::uint64_t key, const TTData &data)
+    {
+        Cluster &cluster = clusters[key & mask];
+        std::uint8_t current = generation.load(std::memory_order_relaxed);
+        Entry *victim = nullptr;
+        int victim_score = 0;
+        for (Entry &entry : cluster.entries)
+        {
+            std::uint64_t word = entry.data.load(std::memory_order_relaxed);
+            if (word == 0 || (entry.check.load(std::memory_order_relaxed) ^ word) == key)
+            {
+                victim = &entry;
+                break;
+            }
+            int age = (current - generation_of(word)) & kGenerationMask;
+            int score = depth_of(word) - 4 * age;
+            if (victim == nullptr || score < victim_score)
+            {
+                victim = &entry;
+                victim_score = score;
+            }
+        }
+
+        Counters &local = local_counters();
+        std::uint64_t old = victim->data.load(std::memory_order_relaxed);
+        if (old != 0 && (victim->check.load(std::memory_order_relaxed) ^ old) != key)
+            local.collisions.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t word = pack(data, current);
+        victim->data.store(word, std::memory_order_relaxed);
+        victim->check.store(key ^ word, std::memory_order_relaxed);
+        local.stores.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Starts a new search generation; entries of older generations
+     *        become the first candidates for replacement.
+     */
+    void TranspositionTable::new_search()
+    {
+        std::uint8_t current = generation.load(std::memory_order_relaxed);
+        generation.store(static_cast<std::uint8_t>(current % kGenerationMask + 1), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Empties every entry and zeroes the counters. Not thread-safe.
+     */
+    void TranspositionTable::clear()
+    {
+        for (Cluster &cluster : clusters)
+        {
+            for (Entry &entry : cluster.entries)
+            {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation.store(1, std::memory_order_relaxed);
+        reset_stats();
+    }
+
+    /**
+     * @brief Sums the per-thread counter stripes.
+     * @return TTStats Hits, misses, stores and collisions so far.
+     */
+    TTStats TranspositionTable::stats() const
+    {
+        TTStats total;
+        for (const Counters &stripe : counters)
+        {
+            total.hits += stripe.hits.load(std::memory_order_relaxed);
+            total.misses += stripe.misses.load(std::memory_order_relaxed);
+            total.stores += stripe.stores.load(std::memory_order_relaxed);
+            total.collisions += stripe.collisions.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Zeroes the usage counters.
+     */
+    void TranspositionTable::reset_stats()
+    {
+        for (Counters &stripe : counters)
+        {
+            stripe.hits.store(0, std::memory_order_relaxed);
+            stripe.misses.store(0, std::memory_order_relaxed);
+            stripe.stores.store(0, std::memory_order_relaxed);
+            stripe.collisions.store(0, std::memory_order_relaxed);
+        }
+    }
+
+}
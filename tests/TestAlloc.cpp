@@ -0,0 +1,119 @@
+#include "doctest.h"
+#include "AllocCounter.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Merchant.hpp"
+#include "Spy.hpp"
+#include "RoleFactory.hpp"
+#include "SimEngine.hpp"
+#include "Strategy.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+// Runs `call` under an allocation scope named after it and fails the test if it allocated
+#define CHECK_NO_ALLOC(call)                                  \
+    do                                                        \
+    {                                                         \
+        AllocScope alloc_scope(#call);                        \
+        call;                                                 \
+        alloc_scope.stop();                                   \
+        CHECK_MESSAGE(alloc_scope.get_allocations() == 0, alloc_scope.report()); \
+    } while (0)
+
+TEST_CASE("AllocScope charges allocations to the innermost call site")
+{
+    std::size_t before = allocation_count();
+    AllocScope outer("outer");
+    {
+        AllocScope inner("inner");
+        std::vector<int> *v = new std::vector<int>(100);
+        delete v;
+        inner.stop();
+        CHECK(inner.get_allocations() == 2);
+        CHECK(inner.get_bytes() >= 100 * sizeof(int));
+        CHECK(outer.get_allocations() == 2); // Handed on when inner stopped
+    }
+    std::unique_ptr<int> one(new int(1));
+    outer.stop();
+    CHECK(outer.get_allocations() == 3);
+    CHECK(allocation_count() - before >= 3);
+    CHECK(outer.report().find("outer: 3 allocations") == 0);
+}
+
+TEST_CASE("Steady-state turns and reactions do not allocate")
+{
+    Game game; // Names longer than the small-string buffer, so any copy would allocate
+    auto governor = std::make_shared<Governor>(game, "Governor with a long name");
+    auto spy = std::make_shared<Spy>(game, "Spy with a rather long name");
+    auto baron = std::make_shared<Baron>(game, "Baron with a rather long name");
+    auto general = std::make_shared<General>(game, "General with a long name");
+    auto judge = std::make_shared<Judge>(game, "Judge with a rather long name");
+    auto merchant = std::make_shared<Merchant>(game, "Merchant with a long name");
+    for (const auto &p : {std::static_pointer_cast<Player>(governor), std::static_pointer_cast<Player>(spy),
+                          std::static_pointer_cast<Player>(baron), std::static_pointer_cast<Player>(general),
+                          std::static_pointer_cast<Player>(judge), std::static_pointer_cast<Player>(merchant)})
+    {
+        game.add_player(p);
+        p->increase_coins(9);
+    }
+    const std::string judge_name = judge->get_name();
+    ActionStatus status = ActionStatus::Ok;
+
+    CHECK_NO_ALLOC(game.turn());
+    CHECK_NO_ALLOC(game.get_player(judge_name));
+    CHECK_NO_ALLOC(game.legal_actions());
+    CHECK_NO_ALLOC(game.get_current_player()->role_id());
+
+    CHECK_NO_ALLOC(governor->tax());
+    CHECK_NO_ALLOC(spy->tax());
+    CHECK_NO_ALLOC(status = governor->try_undo_tax()); // Reaction, out of turn
+    CHECK(status == ActionStatus::Ok);
+    CHECK_NO_ALLOC(baron->invest());
+    CHECK_NO_ALLOC(general->bribe());
+    CHECK_NO_ALLOC(status = judge->try_undo_bribe(general->get_id()));
+    CHECK(status == ActionStatus::Ok);
+    CHECK_NO_ALLOC(general->gather()); // The turn the bribe paid for
+    CHECK_NO_ALLOC(judge->arrest(merchant));
+    CHECK_NO_ALLOC(merchant->sanction(judge));
+    CHECK_NO_ALLOC(status = spy->try_peek_and_disable(baron->get_id()));
+    CHECK(status == ActionStatus::Ok);
+    CHECK_NO_ALLOC(game.next_turn()); // The Governor must coup; skip
+    CHECK_NO_ALLOC(spy->coup(baron));
+    CHECK_NO_ALLOC(status = general->try_undo_coup(baron->get_id()));
+    CHECK(status == ActionStatus::Ok);
+    CHECK_NO_ALLOC(game.pass_turn());
+    CHECK(!baron->is_eliminated());
+    CHECK(game.get_history().size() > 5);
+}
+
+TEST_CASE("Full self-play games do not allocate once the table is seated")
+{
+    Game game;
+    const char *roles[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+    for (const char *role : roles)
+        game.add_player(create_player(game, role, role));
+    const GameState deal = game.get_state();
+    RandomStrategy bot;
+    SimRng rng(3);
+
+    AllocScope turns("SimEngine::apply over 20 games");
+    for (int g = 0; g < 20; ++g)
+    {
+        game.set_state(deal);
+        for (int ply = 0; ply < 500 && !game.is_game_over(); ++ply)
+        {
+            PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+            if (!SimEngine::apply(game, bot.choose_action(game, actor, rng)))
+                game.pass_turn();
+        }
+    }
+    turns.stop();
+    CHECK_MESSAGE(turns.get_allocations() == 0, turns.report());
+}
@@ -0,0 +1,95 @@
+#include "doctest.h"
+#include "Game.hpp"
+#include "EventSink.hpp"
+#include "Baron.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include <sstream>
+#include <vector>
+
+using namespace coup;
+
+namespace
+{
+    // Keeps every event it receives
+    class RecordingSink : public EventSink
+    {
+    public:
+        std::vector<GameEvent> events;
+        void on_event(const GameEvent &event) override { events.push_back(event); }
+    };
+}
+
+TEST_CASE("Actions emit structured events")
+{
+    Game game;
+    RecordingSink sink;
+    game.set_event_sink(&sink);
+    auto gov = std::make_shared<Governor>(game, "Gov");
+    auto baron = std::make_shared<Baron>(game, "Baron");
+    game.add_player(gov);
+    game.add_player(baron);
+
+    gov->gather();
+    baron->tax();
+    gov->arrest(baron);
+
+    REQUIRE(sink.events.size() == 3);
+    CHECK(sink.events[0].type == EventType::Gather);
+    CHECK(sink.events[0].actor == gov->get_id());
+    CHECK(sink.events[0].target == kNoPlayer);
+    CHECK(sink.events[0].turn == 0);
+    CHECK(sink.events[1].type == EventType::Tax);
+    CHECK(sink.events[1].amount == 2);
+    CHECK(sink.events[2].type == EventType::Arrest);
+    CHECK(sink.events[2].target == baron->get_id());
+    CHECK(sink.events[2].turn == 2);
+}
+
+TEST_CASE("Games without a sink stay silent")
+{
+    Game game;
+    CHECK(game.get_event_sink() == nullptr);
+    auto a = std::make_shared<Spy>(game, "A");
+    auto b = std::make_shared<Spy>(game, "B");
+    game.add_player(a);
+    game.add_player(b);
+    CHECK_NOTHROW(a->gather());
+}
+
+TEST_CASE("TextSink prints the classic log lines")
+{
+    Game game;
+    std::ostringstream out;
+    {
+        TextSink sink(game, out, 8); // Tiny buffer forces several writes
+        game.set_event_sink(&sink);
+        auto a = std::make_shared<Spy>(game, "Alice");
+        auto b = std::make_shared<Spy>(game, "Bob");
+        game.add_player(a);
+        game.add_player(b);
+        a->gather();
+        b->arrest(a);
+        game.set_event_sink(nullptr);
+    }
+    CHECK(out.str() == "Alice preformed gather! \n\nBob preformed arrest on Alice! \n\n");
+}
+
+TEST_CASE("BinarySink records round-trip")
+{
+    std::ostringstream out;
+    GameEvent in{EventType::UndoTax, 2, 4, -3, 70000};
+    {
+        BinarySink sink(out, 1); // One record per write
+        sink.on_event(in);
+        sink.on_event(in);
+    }
+    std::string bytes = out.str();
+    REQUIRE(bytes.size() == 2 * BinarySink::kRecordSize);
+    GameEvent back = BinarySink::decode(reinterpret_cast<const std::uint8_t *>(bytes.data()) + BinarySink::kRecordSize);
+    CHECK(back.type == in.type);
+    CHECK(back.actor == in.actor);
+    CHECK(back.target == in.target);
+    CHECK(back.amount == in.amount);
+    CHECK(back.turn == in.turn);
+}
@@ -8,7 +8,10 @@
 #include "General.hpp"
 #include "Judge.hpp"
 #include "Merchant.hpp"
+#include "RoleFactory.hpp"
+#include "Zobrist.hpp"
 #include "exceptions.hpp"
+#include <cstring>
 
 using namespace coup;
 
@@ -62,13 +65,25 @@ TEST_CASE("Game::remove_player and get_active_players_count") {
     CHECK(p1->is_eliminated());
     CHECK(game.get_active_players_count() == 1);
     CHECK_THROWS_AS(game.remove_player("X"), PlayerNotFoundException);
+    CHECK_THROWS_AS(game.remove_player(PlayerId(2)), PlayerNotFoundException);
+    CHECK_THROWS_AS(game.remove_player(kNoPlayer), PlayerNotFoundException);
+    CHECK(game.get_active_players_count() == 1);
 }
 
 TEST_CASE("Game::add_to_coup and is_in_coup_list") {
     Game game;
+    auto a = std::make_shared<Spy>(game, "A");
+    auto b = std::make_shared<Spy>(game, "B");
+    game.add_player(a);
+    game.add_player(b);
     game.add_to_coup("A", "B");
     CHECK(game.is_in_coup_list("B"));
+    CHECK(game.get_coup_attacker(b->get_id()) == a->get_id());
+    CHECK_FALSE(game.is_in_coup_list("A"));
     CHECK_FALSE(game.is_in_coup_list("C"));
+    CHECK_THROWS_AS(game.add_to_coup("A", "C"), PlayerNotFoundException);
+    game.remove_from_coup_list(b->get_id());
+    CHECK_FALSE(game.is_in_coup_list("B"));
 }
 
 TEST_CASE("Game::winner") {
@@ -108,10 +123,531 @@ TEST_CASE("Game::next_turn and reset flags") {
     static_cast<Spy*>(spy.get())->reset_peek_and_disable_flag();
 }
 
-TEST_CASE("Game::get_tax_turns and get(/set)_last_arrested_name") {
+TEST_CASE("Game::get(/set)_tax_turn and get(/set)_last_arrested_name") {
     Game game;
-    game.get_tax_turns()["Alice"] = 3;
-    CHECK(game.get_tax_turns().at("Alice") == 3);
+    game.add_player(std::make_shared<Spy>(game, "Alice"));
+    game.add_player(std::make_shared<Spy>(game, "Bob"));
+    PlayerId alice = game.find_player_id("Alice");
+    CHECK(alice == 0);
+    CHECK(game.find_player_id("Nobody") == kNoPlayer);
+    game.set_tax_turn(alice, 3);
+    CHECK(game.get_tax_turn(alice) == 3);
+    CHECK(game.get_last_arrested_name() == "");
     game.set_last_arrested_name("Bob");
     CHECK(game.get_last_arrested_name() == "Bob");
+    CHECK(game.get_last_arrested() == game.find_player_id("Bob"));
+    CHECK_THROWS_AS(game.set_last_arrested_name("Nobody"), PlayerNotFoundException);
+}
+
+TEST_CASE("GameState is a copyable value that restores the game") {
+    static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be memcpy-able");
+
+    Game game;
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    auto baron = std::make_shared<Baron>(game, "Baron");
+    game.add_player(spy);
+    game.add_player(baron);
+    CHECK(spy->get_id() == 0);
+    CHECK(baron->get_id() == 1);
+
+    spy->tax();
+    GameState saved = game.get_state();
+    CHECK(saved.players[0].coins == 2);
+    CHECK(saved.turn_index == 1);
+
+    baron->tax();
+    spy->increase_coins(3);
+    baron->mark_sanctioned("Spy");
+    CHECK(game.turn() == "Spy");
+
+    game.set_state(saved);
+    CHECK(spy->get_coins() == 2);
+    CHECK(baron->get_coins() == 0);
+    CHECK_FALSE(baron->is_sanctioned());
+    CHECK(game.turn() == "Baron");
+
+    Game other;
+    other.add_player(std::make_shared<Spy>(other, "Solo"));
+    CHECK_THROWS_AS(other.set_state(saved), StateMismatchException);
+}
+
+// Field by field, since padding bytes are not copied reliably
+static bool same_state(const GameState &a, const GameState &b) {
+    if (a.global_turn_index != b.global_turn_index || a.current_round != b.current_round ||
+        a.player_count != b.player_count || a.turn_index != b.turn_index || a.last_arrested != b.last_arrested ||
+        a.latest_tax != b.latest_tax || a.tax_window != b.tax_window || a.alive != b.alive ||
+        a.abilities_used != b.abilities_used || a.hash != b.hash)
+        return false;
+    for (std::size_t i = 0; i < kMaxPlayers; ++i) {
+        const PlayerState &p = a.players[i], &q = b.players[i];
+        if (p.coins != q.coins || p.role != q.role || p.extra_turns != q.extra_turns ||
+            p.disable_arrest_turns != q.disable_arrest_turns || p.flags != q.flags || p.sanctioned_by != q.sanctioned_by ||
+            p.couped_by != q.couped_by || p.sanctions_by != q.sanctions_by || p.coups_by != q.coups_by ||
+            p.last_tax.turn != q.last_tax.turn || p.last_tax.amount != q.last_tax.amount ||
+            p.last_tax.undoable != q.last_tax.undoable || p.last_tax.previous != q.last_tax.previous)
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("copy_state copies the used seats and equals a full copy") {
+    Game big(8);
+    for (int i = 0; i < 5; ++i)
+        big.add_player(create_player(big, "Baron", "B" + std::to_string(i)));
+    big.get_all_players()[0]->increase_coins(6);
+    big.get_all_players()[0]->sanction(big.get_all_players()[3]);
+    big.get_all_players()[1]->tax();
+    big.add_to_coup(2, 4);
+
+    Game small;
+    small.add_player(create_player(small, "Spy", "S0"));
+    small.add_player(create_player(small, "Judge", "S1"));
+    small.get_all_players()[1]->increase_coins(2);
+
+    GameState target = big.get_state();
+    CHECK_FALSE(same_state(target, small.get_state()));
+    copy_state(target, small.get_state()); // Seats 2..4 of target must be emptied
+    CHECK(same_state(target, small.get_state()));
+
+    copy_state(target, big.get_state());
+    CHECK(same_state(target, big.get_state()));
+    CHECK(target.players[0].sanctions_by == player_bit(3));
+    CHECK(target.players[4].couped_by == 2);
+    CHECK(target.hash == hash_state(target));
+}
+
+TEST_CASE("Player state moves into the game when added") {
+    Game game;
+    auto p = std::make_shared<Merchant>(game, "M");
+    p->increase_coins(4);
+    p->mark_eliminated();
+    game.add_player(p);
+    CHECK(game.get_state().players[0].coins == 4);
+    CHECK(game.get_state().players[0].has(PlayerFlag::Eliminated));
+    p->revive();
+    CHECK_FALSE(game.get_state().players[0].has(PlayerFlag::Eliminated));
+}
+
+namespace
+{
+    // Plays one action through the try_* API (role abilities only for matching roles)
+    ActionStatus play(Game &game, const Action &action)
+    {
+        Player &p = *game.get_all_players()[action.actor];
+        switch (action.kind)
+        {
+        case ActionKind::Gather: return p.try_gather();
+        case ActionKind::Tax: return p.try_tax();
+        case ActionKind::Bribe: return p.try_bribe();
+        case ActionKind::Arrest: return p.try_arrest(action.target);
+        case ActionKind::Sanction: return p.try_sanction(action.target);
+        case ActionKind::Coup: return p.try_coup(action.target);
+        case ActionKind::Invest:
+            return p.role_id() == RoleId::Baron ? static_cast<Baron &>(p).try_invest() : ActionStatus::InvalidTarget;
+        case ActionKind::UndoTax:
+            return p.role_id() == RoleId::Governor ? static_cast<Governor &>(p).try_undo_tax() : ActionStatus::InvalidTarget;
+        case ActionKind::UndoBribe:
+            return p.role_id() == RoleId::Judge ? static_cast<Judge &>(p).try_undo_bribe(action.target) : ActionStatus::InvalidTarget;
+        case ActionKind::UndoCoup:
+            return p.role_id() == RoleId::General ? static_cast<General &>(p).try_undo_coup(action.target) : ActionStatus::InvalidTarget;
+        case ActionKind::PeekAndDisable:
+            return p.role_id() == RoleId::Spy ? static_cast<Spy &>(p).try_peek_and_disable(action.target) : ActionStatus::InvalidTarget;
+        default: return ActionStatus::InvalidTarget;
+        }
+    }
+}
+
+TEST_CASE("Game::legal_actions agrees with the try_* API")
+{
+    Game game;
+    game.add_player(std::make_shared<Governor>(game, "Gov"));
+    game.add_player(std::make_shared<Judge>(game, "Judge"));
+    game.add_player(std::make_shared<General>(game, "General"));
+    game.add_player(std::make_shared<Spy>(game, "Spy"));
+    game.add_player(std::make_shared<Baron>(game, "Baron"));
+    game.add_player(std::make_shared<Merchant>(game, "Merchant"));
+    const PlayerId count = static_cast<PlayerId>(game.get_all_players().size());
+
+    unsigned seed = 12345;
+    int mismatches = 0;
+    for (int step = 0; step < 300 && game.get_active_players_count() > 1; ++step)
+    {
+        for (PlayerId actor = 0; actor < count; ++actor)
+        {
+            ActionSet legal = game.legal_actions(actor);
+            for (std::size_t k = 0; k < kActionKindCount; ++k)
+            {
+                ActionKind kind = static_cast<ActionKind>(k);
+                for (PlayerId target = 0; target <= count; ++target)
+                {
+                    PlayerId t = target == count ? kNoTarget : target;
+                    if (is_targeted(kind) == (t == kNoTarget))
+                        continue;
+                    GameState saved = game.get_state();
+                    bool accepted = play(game, Action{kind, actor, t}) == ActionStatus::Ok;
+                    game.set_state(saved);
+                    if (accepted != legal.allows(kind, t))
+                        mismatches++;
+                }
+            }
+        }
+
+        // Advance with a pseudo-random legal move of the current player
+        ActionSet legal = game.legal_actions();
+        std::vector<Action> moves;
+        legal.for_each(static_cast<PlayerId>(game.get_turn_index()), [&](const Action &a) { moves.push_back(a); });
+        CHECK(moves.size() == legal.count());
+        seed = seed * 1103515245u + 12345u;
+        if (moves.empty())
+            game.next_turn();
+        else
+            CHECK(play(game, moves[(seed >> 8) % moves.size()]) == ActionStatus::Ok);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Zobrist hash is kept up to date by every action")
+{
+    int mismatches = 0;
+    for (unsigned seed = 1; seed <= 5; ++seed)
+    {
+        Game game;
+        game.add_player(std::make_shared<Governor>(game, "Gov"));
+        game.add_player(std::make_shared<Judge>(game, "Judge"));
+        game.add_player(std::make_shared<General>(game, "General"));
+        game.add_player(std::make_shared<Spy>(game, "Spy"));
+        game.add_player(std::make_shared<Baron>(game, "Baron"));
+        game.add_player(std::make_shared<Merchant>(game, "Merchant"));
+        const PlayerId count = static_cast<PlayerId>(game.get_all_players().size());
+        if (game.get_hash() != hash_state(game.get_state()))
+            mismatches++;
+
+        for (int step = 0; step < 400 && !game.is_game_over(); ++step)
+        {
+            // Any player may act, so out-of-turn abilities are exercised too
+            seed = seed * 1103515245u + 12345u;
+            PlayerId actor = step % 3 == 2 ? static_cast<PlayerId>((seed >> 8) % count) : static_cast<PlayerId>(game.get_turn_index());
+            std::vector<Action> moves;
+            game.legal_actions(actor).for_each(actor, [&](const Action &a) { moves.push_back(a); });
+            if (moves.empty())
+                continue;
+            if (play(game, moves[(seed >> 12) % moves.size()]) != ActionStatus::Ok ||
+                game.get_hash() != hash_state(game.get_state()))
+                mismatches++;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Zobrist hash identifies positions, not histories")
+{
+    Game game;
+    auto a = std::make_shared<Baron>(game, "A");
+    auto b = std::make_shared<Baron>(game, "B");
+    game.add_player(a);
+    game.add_player(b);
+    const std::uint64_t start = game.get_hash();
+
+    GameState saved = game.get_state();
+    a->gather();
+    CHECK(game.get_hash() != start);
+    b->gather();
+    a->decrease_coins(1);
+    b->decrease_coins(1);
+    CHECK(game.get_current_round() == 2);
+    CHECK(game.get_hash() == start); // Same position one round later
+
+    a->gather();
+    game.set_state(saved);
+    CHECK(game.get_hash() == start);
+}
+
+TEST_CASE("Game over state is cached and winner changes are reported")
+{
+    struct WinnerLog : EventSink
+    {
+        std::vector<PlayerId> winners;
+        void on_event(const GameEvent &event) override
+        {
+            if (event.type == EventType::WinnerChanged)
+                winners.push_back(event.actor);
+        }
+    } log;
+
+    Game game;
+    game.set_event_sink(&log);
+    auto a = std::make_shared<Spy>(game, "A");
+    auto b = std::make_shared<Spy>(game, "B");
+    auto c = std::make_shared<Spy>(game, "C");
+    game.add_player(a);
+    game.add_player(b);
+    game.add_player(c);
+    CHECK_FALSE(game.is_game_over());
+    CHECK(game.get_winner() == kNoPlayer);
+    CHECK(game.get_active_players_count() == 3);
+
+    b->mark_eliminated();
+    b->mark_eliminated(); // No double counting
+    CHECK(game.get_active_players_count() == 2);
+    c->mark_eliminated();
+    CHECK(game.is_game_over());
+    CHECK(game.get_winner() == a->get_id());
+    CHECK(game.winner() == "A");
+
+    c->revive();
+    CHECK_FALSE(game.is_game_over());
+    CHECK(game.get_winner() == kNoPlayer);
+
+    REQUIRE(log.winners.size() == 2);
+    CHECK(log.winners[0] == a->get_id());
+    CHECK(log.winners[1] == kNoPlayer);
+}
+
+TEST_CASE("Alive mask follows eliminations and drives the turn order")
+{
+    Game game;
+    auto a = std::make_shared<Spy>(game, "A");
+    auto b = std::make_shared<Spy>(game, "B");
+    auto c = std::make_shared<Spy>(game, "C");
+    auto d = std::make_shared<Spy>(game, "D");
+    game.add_player(a);
+    game.add_player(b);
+    game.add_player(c);
+    game.add_player(d);
+    CHECK(game.get_alive_mask() == 0b1111);
+
+    b->mark_eliminated();
+    c->mark_eliminated();
+    CHECK(game.get_alive_mask() == 0b1001);
+    CHECK(game.get_active_players_count() == 2);
+
+    game.next_turn(); // A -> D, skipping B and C
+    CHECK(game.turn() == "D");
+    int round = game.get_current_round();
+    game.next_turn(); // D -> A starts a new round
+    CHECK(game.turn() == "A");
+    CHECK(game.get_current_round() == round + 1);
+
+    c->revive();
+    CHECK(game.get_alive_mask() == 0b1101);
+
+    CHECK(mask_next(0b1101, 0) == 2);
+    CHECK(mask_next(0b1101, 3) == 0);
+    CHECK(mask_first(0) == kNoPlayer);
+    CHECK(mask_count(~PlayerMask(0)) == 64);
+}
+
+TEST_CASE("Action history is a bounded ring with a spill hook") {
+    Game game;
+    auto a = std::make_shared<Spy>(game, "A");
+    auto b = std::make_shared<Spy>(game, "B");
+    game.add_player(a);
+    game.add_player(b);
+
+    std::vector<HistoryEntry> spilled;
+    game.set_history_spill([&spilled](const HistoryEntry &entry) { spilled.push_back(entry); });
+
+    const std::size_t extra = 10;
+    for (std::size_t i = 0; i < ActionHistory::capacity() + extra; ++i) {
+        auto &current = game.get_current_player();
+        if (current->get_coins() > 0)
+            current->decrease_coins(current->get_coins()); // Stay below the forced-coup limit
+        current->gather();
+    }
+
+    const ActionHistory &history = game.get_history();
+    CHECK(history.size() == ActionHistory::capacity());
+    CHECK(history.total_pushed() == ActionHistory::capacity() + extra);
+    REQUIRE(spilled.size() == extra);
+    CHECK(spilled[0].actor == a->get_id()); // Oldest entries leave first
+    CHECK(spilled[1].actor == b->get_id());
+    CHECK(history[0].round >= spilled.back().round);
+    CHECK(history.back().kind == ActionKind::Gather);
+    CHECK(history.back().amount == 1);
+
+    auto view = game.get_action_history();
+    REQUIRE(view.size() == history.size());
+    CHECK(std::get<0>(view.back()) == "B");
+    CHECK(std::get<1>(view.back()) == "gather");
+    CHECK(std::get<2>(view.back()) == game.get_current_round() - 1);
+}
+
+TEST_CASE("Action history rewinds, bringing evicted entries back") {
+    ActionHistory history;
+    auto push = [&history](int n) {
+        for (int i = 0; i < n; ++i)
+            history.push(HistoryEntry{ActionKind::Gather, 0, kNoTarget, static_cast<std::int16_t>(history.total_pushed()), 0, 0});
+    };
+    push(ActionHistory::capacity() + 5);
+    const std::uint64_t mark = history.total_pushed();
+    push(20); // Evicts 20 entries
+    history.rewind(mark);
+    CHECK(history.total_pushed() == mark);
+    CHECK(history.size() == ActionHistory::capacity());
+    CHECK(history[0].amount == 5); // The evicted entries are back
+    CHECK(history.back().amount == static_cast<int>(mark) - 1);
+
+    push(ActionHistory::kSlack + 10);
+    history.rewind(mark); // Deeper than the slack: the oldest entries are gone for good
+    CHECK(history.total_pushed() == mark);
+    CHECK(history.size() == ActionHistory::capacity() - 10);
+    CHECK(history.back().amount == static_cast<int>(mark) - 1);
+
+    history.rewind(mark + 1); // Nothing newer to take back
+    CHECK(history.total_pushed() == mark);
+}
+
+TEST_CASE("Game::snapshot and restore round-trip every part of the state") {
+    Game game;
+    auto gov = std::make_shared<Governor>(game, "Gov");
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    auto baron = std::make_shared<Baron>(game, "Baron");
+    auto general = std::make_shared<General>(game, "General");
+    game.add_player(gov);
+    game.add_player(spy);
+    game.add_player(baron);
+    game.add_player(general);
+
+    gov->tax();
+    spy->tax();
+    gov->undo_tax(); // Tax record and round ability
+    baron->increase_coins(8);
+    baron->sanction(spy);
+    general->gather();
+    gov->increase_coins(7);
+    gov->coup(general); // Coup record, elimination
+    spy->peek_and_disable(baron);
+
+    const GameState before = game.get_state();
+    std::vector<std::uint8_t> blob = game.snapshot();
+    CHECK(blob.size() < 160);
+
+    game.next_turn();
+    baron->gather();
+    CHECK(game.get_hash() != before.hash);
+
+    game.restore(blob); // Rollback: same Player objects, no new seats
+    CHECK(game.get_hash() == before.hash);
+    CHECK(game.get_all_players().size() == 4);
+    CHECK(game.get_all_players()[1] == spy);
+    CHECK(spy->get_coins() == before.players[1].coins);
+    CHECK(spy->is_sanctioned());
+    CHECK(general->is_eliminated());
+    CHECK(game.get_coup_attacker(general->get_id()) == gov->get_id());
+    CHECK(game.get_latest_tax() == before.latest_tax);
+    CHECK(game.get_global_turn_index() == before.global_turn_index);
+    CHECK(game.get_history().empty());
+    CHECK(std::memcmp(&game.get_state().players, &before.players, sizeof(before.players)) == 0);
+
+    Game recovered; // Crash recovery: the blob seats its own players
+    recovered.restore(blob);
+    REQUIRE(recovered.get_all_players().size() == 4);
+    CHECK(recovered.get_hash() == before.hash);
+    CHECK(recovered.get_all_players()[2]->get_name() == "Baron");
+    CHECK(recovered.get_all_players()[2]->role_id() == RoleId::Baron);
+    CHECK(recovered.turn() == game.turn());
+    recovered.next_turn();
+    game.next_turn();
+    recovered.get_current_player()->gather();
+    game.get_current_player()->gather();
+    CHECK(recovered.get_hash() == game.get_hash()); // Both continue identically
+}
+
+TEST_CASE("Game::restore rejects corrupt blobs and other tables") {
+    Game game;
+    game.add_player(std::make_shared<Judge>(game, "A"));
+    game.add_player(std::make_shared<Merchant>(game, "B"));
+    game.get_current_player()->gather();
+    std::vector<std::uint8_t> blob;
+    game.snapshot(blob);
+
+    std::vector<std::uint8_t> corrupt = blob;
+    corrupt[corrupt.size() - 12] ^= 0x01;
+    CHECK_THROWS_AS(game.restore(corrupt), SnapshotFormatException);
+    CHECK_THROWS_AS(game.restore(blob.data(), blob.size() - 1), SnapshotFormatException);
+    std::vector<std::uint8_t> future = blob;
+    future[2] = 99; // Unknown version (the checksum catches it too)
+    CHECK_THROWS_AS(game.restore(future), SnapshotFormatException);
+
+    Game other;
+    other.add_player(std::make_shared<Judge>(other, "A"));
+    other.add_player(std::make_shared<Spy>(other, "B"));
+    CHECK_THROWS_AS(other.restore(blob), StateMismatchException);
+
+    const std::uint64_t hash = game.get_hash();
+    game.restore(blob);
+    CHECK(game.get_hash() == hash);
+}
+
+TEST_CASE("Game table size is configurable up to kMaxPlayers") {
+    Game standard;
+    CHECK(standard.get_max_players() == kDefaultMaxPlayers);
+    CHECK_THROWS_AS(Game(0), InvalidTableSizeException);
+    CHECK_THROWS_AS(Game(kMaxPlayers + 1), InvalidTableSizeException);
+
+    Game big(kMaxPlayers);
+    for (std::size_t i = 0; i < kMaxPlayers; ++i)
+        big.add_player(std::make_shared<Merchant>(big, "P" + std::to_string(i)));
+    CHECK(big.get_active_players_count() == 64);
+    CHECK_THROWS_AS(big.add_player(std::make_shared<Spy>(big, "Extra")), MaxPlayersExceededException);
+    CHECK(big.get_player("P63")->get_id() == 63);
+    CHECK_THROWS_AS(big.set_max_players(10), InvalidTableSizeException); // Below the seated players
+
+    Game growing;
+    for (int i = 0; i < 6; ++i)
+        growing.add_player(std::make_shared<Baron>(growing, "B" + std::to_string(i)));
+    CHECK_THROWS_AS(growing.add_player(std::make_shared<Baron>(growing, "B6")), MaxPlayersExceededException);
+    growing.set_max_players(7);
+    growing.add_player(std::make_shared<Baron>(growing, "B6"));
+    CHECK(growing.get_all_players().size() == 7);
+}
+
+TEST_CASE("Large tables keep turn bookkeeping and snapshots consistent") {
+    Game game(40);
+    std::vector<std::shared_ptr<Player>> seats;
+    for (int i = 0; i < 40; ++i) {
+        std::shared_ptr<Player> p;
+        switch (i % 4) {
+            case 0: p = std::make_shared<General>(game, "General" + std::to_string(i)); break;
+            case 1: p = std::make_shared<Judge>(game, "Judge" + std::to_string(i)); break;
+            case 2: p = std::make_shared<Spy>(game, "Spy" + std::to_string(i)); break;
+            default: p = std::make_shared<Merchant>(game, "Merchant" + std::to_string(i)); break;
+        }
+        game.add_player(p);
+        seats.push_back(p);
+    }
+
+    // Seat 37 coups seat 12; the record lasts until 37's next turn
+    for (int i = 0; i < 37; ++i)
+        game.next_turn();
+    seats[37]->increase_coins(7);
+    seats[37]->coup(seats[12]);
+    CHECK(game.get_coup_attacker(12) == 37);
+    CHECK(game.is_in_coup_list("General12"));
+
+    // Spend the abilities of a few players; the next round resets them
+    std::static_pointer_cast<Judge>(seats[1])->mark_undo_bribe_used();
+    std::static_pointer_cast<Spy>(seats[38])->mark_peek_and_disable_used();
+    std::static_pointer_cast<General>(seats[36])->mark_undo_coup_used();
+    CHECK(game.get_state().abilities_used == (player_bit(1) | player_bit(36) | player_bit(38)));
+    CHECK(game.get_hash() == hash_state(game.get_state()));
+
+    std::vector<std::uint8_t> blob = game.snapshot();
+    Game recovered; // Default size: the blob's table size wins
+    recovered.restore(blob);
+    CHECK(recovered.get_all_players().size() == 40);
+    CHECK(recovered.get_max_players() == 40);
+    CHECK(recovered.get_state().abilities_used == game.get_state().abilities_used);
+    CHECK(recovered.get_state().players[37].coups_by == player_bit(12));
+
+    while (game.get_turn_index() != 0) // Through the end of the round (seat 12 is skipped)
+        game.next_turn();
+    CHECK(game.get_state().abilities_used == 0);
+    CHECK(std::static_pointer_cast<Judge>(seats[1])->can_undo_bribe());
+    CHECK(game.get_coup_attacker(12) == 37);
+    while (game.get_turn_index() != 37)
+        game.next_turn();
+    CHECK(game.get_coup_attacker(12) == kNoPlayer); // Dropped at the attacker's turn
+    CHECK(game.get_state().players[37].coups_by == 0);
+    CHECK(game.get_hash() == hash_state(game.get_state()));
 }
@@ -413,3 +413,67 @@ TEST_CASE("Player::clear_sanctioned") {
     p1->clear_sanctioned();
     CHECK_FALSE(p1->is_sanctioned());
 }
+
+TEST_CASE("Player::try_* actions report status without throwing") {
+    Game game;
+    auto p1 = std::make_shared<Spy>(game, "P1");
+    auto p2 = std::make_shared<Merchant>(game, "P2");
+    game.add_player(p1);
+    game.add_player(p2);
+
+    CHECK(p2->try_gather() == ActionStatus::NotYourTurn);
+    CHECK(p1->try_bribe() == ActionStatus::NotEnoughCoins);
+    CHECK(p1->try_arrest(p2->get_id()) == ActionStatus::TargetNoCoins);
+    CHECK(p1->try_arrest(p1->get_id()) == ActionStatus::CannotTargetYourself);
+    CHECK(p1->try_coup(p2->get_id()) == ActionStatus::NotEnoughCoins);
+    CHECK(p1->try_sanction(42) == ActionStatus::InvalidTarget);
+    CHECK(p1->get_coins() == 0); // Refused actions change nothing
+    CHECK(game.turn() == "P1");
+
+    CHECK(p1->try_gather() == ActionStatus::Ok);
+    CHECK(p1->get_coins() == 1);
+    CHECK(game.turn() == "P2");
+}
+
+TEST_CASE("A refused sanction leaves a Baron's coins alone") {
+    Game game;
+    auto p1 = std::make_shared<Spy>(game, "P1");
+    auto baron = std::make_shared<Baron>(game, "Baron");
+    game.add_player(p1);
+    game.add_player(baron);
+
+    CHECK(p1->try_sanction(baron->get_id()) == ActionStatus::NotEnoughCoins);
+    CHECK_THROWS_AS(p1->sanction(baron), NotEnoughCoinsException);
+    CHECK(baron->get_coins() == 0);
+
+    p1->increase_coins(3);
+    CHECK(p1->try_sanction(baron->get_id()) == ActionStatus::Ok);
+    CHECK(baron->get_coins() == 1); // Refund once the sanction goes through
+    CHECK(p1->get_coins() == 0);
+}
+
+TEST_CASE("Sanctions are lifted through the sanctioner's reverse index") {
+    Game game;
+    auto p1 = std::make_shared<Spy>(game, "P1");
+    auto p2 = std::make_shared<Spy>(game, "P2");
+    auto p3 = std::make_shared<Spy>(game, "P3");
+    game.add_player(p1);
+    game.add_player(p2);
+    game.add_player(p3);
+
+    p3->mark_sanctioned(p1->get_id());
+    CHECK(game.get_state().players[p1->get_id()].sanctions_by == player_bit(p3->get_id()));
+
+    p3->mark_sanctioned(p2->get_id()); // Re-sanctioned by someone else
+    CHECK(game.get_state().players[p1->get_id()].sanctions_by == 0);
+    CHECK(game.get_state().players[p2->get_id()].sanctions_by == player_bit(p3->get_id()));
+
+    game.next_turn(); // P2 starts a turn: their sanctions end
+    CHECK_FALSE(p3->is_sanctioned());
+    CHECK(p3->get_sanctioned_by() == kNoPlayer);
+    CHECK(game.get_state().players[p2->get_id()].sanctions_by == 0);
+
+    p1->mark_sanctioned(p3->get_id());
+    p1->clear_sanctioned();
+    CHECK(game.get_state().players[p3->get_id()].sanctions_by == 0);
+}
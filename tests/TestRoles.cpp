@@ -305,3 +305,115 @@ TEST_CASE("Spy::peek_and_disable throws on self or eliminated target")
     game.add_player(t);
     CHECK_THROWS_AS(spy->peek_and_disable(t), TargetIsEliminatedException);
 }
+
+TEST_CASE("Role ids and traits match the role classes")
+{
+    Game game;
+    Governor gov(game, "Gov");
+    Spy spy(game, "Spy");
+    Baron baron(game, "Baron");
+    General general(game, "General");
+    Judge judge(game, "Judge");
+    Merchant merchant(game, "Merchant");
+    const Player *players[] = {&gov, &spy, &baron, &general, &judge, &merchant};
+
+    for (std::size_t i = 0; i < kRoleCount; ++i)
+    {
+        CHECK(players[i]->role_id() == static_cast<RoleId>(i));
+        CHECK(players[i]->role() == players[i]->traits().name);
+    }
+    CHECK(gov.traits().tax_amount == 3);
+    CHECK(judge.traits().sanction_cost == 4);
+    CHECK(baron.traits().sanction_refund == 1);
+    CHECK(merchant.traits().arrest_loss == 2);
+    CHECK(general.traits().arrest_loss == 0);
+    CHECK_FALSE(merchant.traits().round_ability);
+}
+
+TEST_CASE("Round ability flags reset when a new round starts")
+{
+    Game game;
+    auto gov = std::make_shared<Governor>(game, "Gov");
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    game.add_player(gov);
+    game.add_player(spy);
+
+    gov->mark_undo_tax_used();
+    spy->mark_peek_and_disable_used();
+    game.next_turn(); // Spy's turn, same round
+    CHECK_FALSE(spy->can_peek_and_disable());
+    game.next_turn(); // back to Gov: new round
+    CHECK(spy->can_peek_and_disable());
+    CHECK_FALSE(game.get_state().players[gov->get_id()].has(PlayerFlag::AbilityUsed));
+}
+
+TEST_CASE("Role abilities have non-throwing try_* versions")
+{
+    Game game;
+    auto gov = std::make_shared<Governor>(game, "Gov");
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    auto general = std::make_shared<General>(game, "General");
+    auto judge = std::make_shared<Judge>(game, "Judge");
+    game.add_player(gov);
+    game.add_player(spy);
+    game.add_player(general);
+    game.add_player(judge);
+
+    CHECK(gov->try_undo_tax() == ActionStatus::NoRecentAction);
+    CHECK(judge->try_undo_bribe(gov->get_id()) == ActionStatus::NotUndoable);
+    CHECK(general->try_undo_coup(gov->get_id()) == ActionStatus::NotEnoughCoins);
+    general->increase_coins(5);
+    CHECK(general->try_undo_coup(gov->get_id()) == ActionStatus::TargetNotEliminated);
+
+    gov->tax();
+    PlayerId taxed = kNoPlayer;
+    CHECK(gov->try_undo_tax(&taxed) == ActionStatus::CannotUndoOwnAction);
+    CHECK(taxed == gov->get_id());
+
+    CHECK(spy->try_peek_and_disable(spy->get_id()) == ActionStatus::CannotTargetYourself);
+    CHECK(spy->try_peek_and_disable(gov->get_id()) == ActionStatus::Ok);
+    CHECK(spy->try_peek_and_disable(gov->get_id()) == ActionStatus::AbilityUsed);
+    CHECK_THROWS_AS(spy->peek_and_disable(gov), ActionAlreadyUsedThisRoundException);
+    CHECK(gov->is_disable_to_arrest());
+}
+
+TEST_CASE("Governor::undo_tax walks back through last-tax records")
+{
+    Game game;
+    auto gov = std::make_shared<Governor>(game, "Gov");
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    auto baron = std::make_shared<Baron>(game, "Baron");
+    auto gov2 = std::make_shared<Governor>(game, "Gov2");
+    game.add_player(gov);
+    game.add_player(spy);
+    game.add_player(baron);
+    game.add_player(gov2);
+
+    gov->gather();
+    spy->tax();
+    baron->tax();
+    CHECK(game.get_latest_tax() == baron->get_id());
+    CHECK(game.get_last_tax(baron->get_id()).amount == 2);
+
+    CHECK(gov2->undo_tax() == "Gov2 canceled Baron's tax. 2 coins were removed.");
+    CHECK(baron->get_coins() == 0);
+    CHECK_FALSE(game.get_last_tax(baron->get_id()).undoable);
+    CHECK(game.get_latest_tax() == spy->get_id()); // The tax before it is next in line
+
+    CHECK(gov->undo_tax() == "Gov canceled Spy's tax. 2 coins were removed.");
+    CHECK(spy->get_coins() == 0);
+    CHECK(game.get_latest_tax() == kNoPlayer);
+    CHECK(game.get_history().size() == 5); // A gather, two taxes and two undos
+    CHECK(game.get_history().back().kind == ActionKind::UndoTax);
+    CHECK(std::get<1>(game.get_action_history()[1]) == "tax");
+
+    gov2->gather();
+    gov->gather(); // New round
+    spy->tax();
+    baron->gather();
+    gov2->gather();
+    gov->gather();
+    spy->gather(); // A full rotation after the tax
+    CHECK(gov2->check_undo_tax() == ActionStatus::ActionTooOld);
+    CHECK_THROWS_AS(gov2->undo_tax(), ActionTooOldException);
+}
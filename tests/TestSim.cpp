@@ -0,0 +1,968 @@
+#include "doctest.h"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "RoleFactory.hpp"
+#include "Ismcts.hpp"
+#include "Judge.hpp"
+#include "Replay.hpp"
+#include "SimEngine.hpp"
+#include "Spy.hpp"
+#include "TranspositionTable.hpp"
+#include "Zobrist.hpp"
+#include "exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+TEST_CASE("create_player builds every role")
+{
+    Game game;
+    const char *roles[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+    for (const char *role : roles)
+    {
+        std::shared_ptr<Player> p = create_player(game, role, role);
+        CHECK(p->role() == role);
+        CHECK(p->get_name() == role);
+    }
+    CHECK_THROWS_AS(create_player(game, "Duke", "X"), std::invalid_argument);
+}
+
+TEST_CASE("SimEngine plays complete games")
+{
+    SimConfig config;
+    config.games = 50;
+    config.players = 4;
+    config.seed = 7;
+    SimEngine engine(config);
+    engine.set_strategy(1, std::make_shared<GreedyStrategy>());
+
+    SimStats stats = engine.run();
+    CHECK(stats.games == 50);
+    CHECK(stats.actions > 0);
+    CHECK(stats.wins.size() == 4);
+
+    std::size_t decided = 0;
+    for (std::size_t wins : stats.wins)
+        decided += wins;
+    CHECK(decided + stats.draws == stats.games);
+}
+
+TEST_CASE("SimEngine is reproducible for a fixed seed and roster")
+{
+    SimConfig config;
+    config.roles = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+    config.seed = 42;
+
+    SimEngine first(config);
+    SimEngine second(config);
+    SimRng rng1(config.seed);
+    SimRng rng2(config.seed);
+    for (int i = 0; i < 20; ++i)
+    {
+        GameResult a = first.play_game(rng1);
+        GameResult b = second.play_game(rng2);
+        CHECK(a.winner == b.winner);
+        CHECK(a.turns == b.turns);
+        CHECK(a.actions == b.actions);
+    }
+}
+
+TEST_CASE("TranspositionTable stores, finds and replaces entries")
+{
+    CHECK_THROWS_AS(TranspositionTable(0), std::invalid_argument);
+
+    TranspositionTable table(1);
+    CHECK(table.size_bytes() == 1024 * 1024);
+    CHECK(table.entry_count() == table.size_bytes() / 16);
+
+    TTData data;
+    CHECK_FALSE(table.probe(42, data));
+
+    TTData stored;
+    stored.value = -123;
+    stored.depth = 9;
+    stored.bound = TTBound::Lower;
+    stored.best = Action{ActionKind::Coup, 2, 4};
+    table.store(42, stored);
+    REQUIRE(table.probe(42, data));
+    CHECK(data.value == -123);
+    CHECK(data.depth == 9);
+    CHECK(data.bound == TTBound::Lower);
+    CHECK(data.best.kind == ActionKind::Coup);
+    CHECK(data.best.actor == 2);
+    CHECK(data.best.target == 4);
+
+    // Keys sharing a cluster: the shallowest entry of the full cluster is replaced first
+    const std::uint64_t stride = table.entry_count() / TranspositionTable::kClusterSize;
+    for (std::uint64_t i = 1; i < TranspositionTable::kClusterSize; ++i)
+    {
+        stored.depth = static_cast<std::uint8_t>(10 + i);
+        table.store(42 + i * stride, stored);
+    }
+    stored.depth = 20;
+    table.store(42 + 9 * stride, stored);
+    CHECK_FALSE(table.probe(42, data)); // Depth 9 was the shallowest
+    CHECK(table.probe(42 + stride, data));
+    CHECK(table.probe(42 + 9 * stride, data));
+
+    // Entries of an older search go before deeper ones
+    table.new_search();
+    table.new_search();
+    stored.depth = 1;
+    table.store(42 + 10 * stride, stored);
+    CHECK(table.probe(42 + 10 * stride, data));
+    CHECK_FALSE(table.probe(42 + stride, data)); // Depth 11, two searches old
+
+    TTStats stats = table.stats();
+    CHECK(stats.stores == 6);
+    CHECK(stats.collisions == 2);
+    CHECK(stats.hits == 4);
+    CHECK(stats.misses == 3);
+
+    table.clear();
+    CHECK_FALSE(table.probe(42 + stride, data));
+    CHECK(table.stats().stores == 0);
+}
+
+TEST_CASE("TranspositionTable never returns torn entries under concurrent use")
+{
+    TranspositionTable table(1);
+    const std::uint64_t stride = table.entry_count() / TranspositionTable::kClusterSize;
+    std::vector<std::thread> workers;
+    std::vector<int> corrupt(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&table, &corrupt, stride, t]() {
+            for (std::uint64_t i = 0; i < 200000; ++i)
+            {
+                std::uint64_t key = 7 + ((i * 2654435761u + t) % 16) * stride; // 16 keys fighting over one cluster
+                TTData data;
+                if (table.probe(key, data))
+                {
+                    if (data.value != static_cast<std::int16_t>(key >> 8) || data.depth != static_cast<std::uint8_t>(key >> 24))
+                        corrupt[t]++;
+                }
+                data.value = static_cast<std::int16_t>(key >> 8);
+                data.depth = static_cast<std::uint8_t>(key >> 24);
+                table.store(key, data);
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    for (int count : corrupt)
+        CHECK(count == 0);
+    TTStats stats = table.stats();
+    CHECK(stats.stores == 4 * 200000);
+    CHECK(stats.hits + stats.misses == 4 * 200000);
+}
+
+TEST_CASE("MctsSearch finds a winning coup with every kind of parallelism")
+{
+    Game game;
+    auto a = create_player(game, "Baron", "A");
+    auto b = create_player(game, "Spy", "B");
+    auto c = create_player(game, "Governor", "C");
+    game.add_player(a);
+    game.add_player(b);
+    game.add_player(c);
+    c->mark_eliminated();
+    a->increase_coins(7);
+    b->increase_coins(6); // B would coup A next turn
+    const std::uint64_t before = game.get_hash();
+
+    const std::size_t layouts[][2] = {{1, 1}, {4, 1}, {4, 4}, {4, 2}}; // {threads, trees}
+    for (const auto &layout : layouts)
+    {
+        MctsConfig config;
+        config.threads = layout[0];
+        config.trees = layout[1];
+        config.playouts = 400;
+        MctsSearch search(config);
+        Action best = search.search(game, 99);
+        CHECK(best.kind == ActionKind::Coup);
+        CHECK(best.actor == a->get_id());
+        CHECK(best.target == b->get_id());
+        CHECK(search.last_stats().playouts == 400);
+        CHECK(search.last_stats().nodes > 1);
+    }
+    CHECK(game.get_hash() == before); // The searched game is left alone
+}
+
+TEST_CASE("MctsSearch keeps its threads and game copies across searches and tables")
+{
+    Game first;
+    first.add_player(create_player(first, "Baron", "A"));
+    first.add_player(create_player(first, "Spy", "B"));
+    first.get_all_players()[0]->increase_coins(7);
+    first.get_all_players()[1]->increase_coins(6);
+
+    Game second; // Different roles and seat count: the copies must be rebuilt
+    second.add_player(create_player(second, "Judge", "A"));
+    second.add_player(create_player(second, "Merchant", "B"));
+    second.add_player(create_player(second, "General", "C"));
+    second.get_all_players()[0]->increase_coins(7);
+    second.get_all_players()[1]->mark_eliminated();
+    second.get_all_players()[2]->increase_coins(6);
+
+    MctsConfig config;
+    config.threads = 3;
+    config.playouts = 300;
+    MctsSearch reused(config);
+    for (int round = 0; round < 3; ++round)
+    {
+        const Game &game = round == 1 ? second : first;
+        PlayerId victim = round == 1 ? 2 : 1;
+        Action best = reused.search(game, 7 + round);
+        CHECK(best.kind == ActionKind::Coup);
+        CHECK(best.target == victim);
+        CHECK(reused.last_stats().playouts == 300);
+    }
+
+    // One thread is deterministic, so a reused search must match a fresh one
+    config.threads = 1;
+    MctsSearch once(config), twice(config);
+    twice.search(second, 5);
+    for (int seed = 0; seed < 4; ++seed)
+    {
+        Action a = once.search(first, seed);
+        Action b = twice.search(first, seed);
+        CHECK(a.kind == b.kind);
+        CHECK(a.target == b.target);
+        CHECK(once.last_stats().nodes == twice.last_stats().nodes);
+    }
+}
+
+TEST_CASE("MctsSearch honours a time budget and plays full games")
+{
+    Game game;
+    game.add_player(create_player(game, "Governor", "A"));
+    game.add_player(create_player(game, "Judge", "B"));
+    game.add_player(create_player(game, "Merchant", "C"));
+
+    MctsConfig config;
+    config.playouts = 0;
+    config.seconds = 0.05;
+    config.threads = 2;
+    MctsSearch search(config);
+    search.search(game, 1);
+    CHECK(search.last_stats().playouts > 0);
+    CHECK(search.last_stats().seconds >= 0.05);
+    CHECK(search.last_stats().playouts_per_second() > 0);
+
+    SimConfig sim;
+    sim.games = 3;
+    sim.players = 3;
+    SimEngine engine(sim);
+    MctsConfig quick;
+    quick.playouts = 50;
+    auto bot = std::make_shared<MctsStrategy>(quick);
+    engine.set_strategy(0, bot);
+    SimStats stats = engine.run();
+    CHECK(stats.games == 3);
+    CHECK(bot->total_stats().searches > 0);
+    CHECK(bot->total_stats().playouts > 0);
+}
+
+TEST_CASE("CoinTracker keeps payments exact and other players' bank income as ranges")
+{
+    Game game;
+    auto spy = std::make_shared<Spy>(game, "A");
+    auto merchant = create_player(game, "Merchant", "B");
+    auto judge = create_player(game, "Judge", "C");
+    game.add_player(spy);
+    game.add_player(merchant);
+    game.add_player(judge);
+    CoinTracker coins, judge_coins;
+    auto sync = [&]() {
+        coins.sync(game, spy->get_id());
+        judge_coins.sync(game, judge->get_id());
+    };
+    sync();
+    InfoSetView view(game, coins);
+    InfoSetView other(game, judge_coins);
+    CHECK(view.get_observer() == spy->get_id());
+    CHECK(view.coins(merchant->get_id()) == 0); // Nothing taken yet
+
+    for (int round = 0; round < 2; ++round)
+    {
+        spy->gather();
+        merchant->tax();    // 2 or 3 coins, as far as the others know
+        judge->gather();
+    }
+    spy->gather(); // The Merchant starts its turn with 4 coins and silently takes its bonus
+    sync();
+    CHECK(merchant->get_coins() == 5);
+    CHECK_FALSE(view.knows_coins(merchant->get_id()));
+    CHECK(view.min_coins(merchant->get_id()) == 5);
+    CHECK(view.max_coins(merchant->get_id()) == 8); // 2 to 4 after a tax and a possible bonus, then 4 to 7, then the bonus
+    CHECK(other.coins(spy->get_id()) == 3); // Gathering always brings 1
+
+    merchant->gather();
+    judge->arrest(merchant); // The Merchant pays 2 to the bank, the Judge gets nothing
+    sync();
+    CHECK(merchant->get_coins() == 4);
+    CHECK(view.min_coins(merchant->get_id()) == 4);
+    CHECK(view.max_coins(merchant->get_id()) == 7);
+    CHECK(view.coins(judge->get_id()) == 2);
+
+    coins.set_bounds(merchant->get_id(), 1, 4); // A position the spy only partly knows
+    spy->gather();
+    sync(); // Bonus paid at 4 coins, unseen from 1..4
+    CHECK(merchant->get_coins() == 5);
+    CHECK(view.coins(merchant->get_id()) == -1);
+    CHECK(view.min_coins(merchant->get_id()) == 1);
+    CHECK(view.max_coins(merchant->get_id()) == 5);
+
+    merchant->bribe(); // A payment of 4 proves at least 4 were there
+    sync();
+    CHECK(view.min_coins(merchant->get_id()) == 0);
+    CHECK(view.max_coins(merchant->get_id()) == 1);
+    merchant->gather();
+    merchant->gather(); // Extra turns: no new bonus
+    judge->gather();
+    spy->peek_and_disable(merchant);
+    sync();
+    CHECK(view.coins(merchant->get_id()) == merchant->get_coins());
+    CHECK_FALSE(other.knows_coins(merchant->get_id())); // The peek told only the spy
+    CHECK(other.min_coins(merchant->get_id()) <= merchant->get_coins());
+    CHECK(merchant->get_coins() <= other.max_coins(merchant->get_id()));
+
+    coins.set_bounds(judge->get_id(), 9, 9); // Answers come from what the observer knows, not from the real count
+    CHECK(view.coins(judge->get_id()) == 9);
+    CHECK(other.coins(judge->get_id()) == judge->get_coins()); // Its own count is seen
+
+    game.clear_history(); // A new game on the same table starts over
+    sync();
+    CHECK(other.coins(merchant->get_id()) == merchant->get_coins());
+}
+
+TEST_CASE("CoinTracker pays the turn bonus on forced and passed turns")
+{
+    Game game;
+    auto governor = create_player(game, "Governor", "A");
+    auto merchant = create_player(game, "Merchant", "B");
+    auto judge = std::make_shared<Judge>(game, "C");
+    game.add_player(governor);
+    game.add_player(merchant);
+    game.add_player(judge);
+    CoinTracker coins;
+    coins.sync(game, judge->get_id());
+    for (int round = 0; round < 2; ++round)
+    {
+        governor->tax();
+        merchant->tax();
+        judge->gather();
+    }
+    governor->bribe();
+    governor->gather(); // The bribe took effect: the Governor plays its extra turn
+    coins.sync(game, judge->get_id());
+    coins.set_bounds(merchant->get_id(), 4, 4); // Pin the taxes down to follow the bonus alone
+    judge->undo_bribe(governor); // Forces the Merchant's turn, which starts with 4 coins
+    CHECK(game.get_turn_index() == merchant->get_id());
+    CHECK(merchant->get_coins() == 5);
+    coins.sync(game, judge->get_id());
+    CHECK(coins.min_coins(merchant->get_id()) == 5);
+    CHECK(coins.max_coins(merchant->get_id()) == 5);
+
+    game.pass_turn(); // Not logged as an action
+    judge->gather();
+    governor->gather(); // Another bonus at the Merchant's next turn
+    CHECK(merchant->get_coins() == 6);
+    coins.sync(game, judge->get_id());
+    CHECK(coins.min_coins(merchant->get_id()) == 6);
+    CHECK(coins.max_coins(merchant->get_id()) == 6);
+}
+
+TEST_CASE("determinize samples within the bounds and rehashes")
+{
+    Game game;
+    game.add_player(create_player(game, "Governor", "A"));
+    game.add_player(create_player(game, "Merchant", "B"));
+    game.add_player(create_player(game, "Judge", "C"));
+    SimRng rng(5);
+    auto bots = std::make_shared<RandomStrategy>();
+    CoinTracker coins;
+    coins.sync(game, 0);
+    for (int turn = 0; turn < 12 && !game.is_game_over(); ++turn)
+    {
+        PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+        SimEngine::apply(game, bots->choose_action(game, actor, rng));
+    }
+    coins.sync(game, 0);
+    for (PlayerId p = 0; p < 3; ++p)
+    {
+        CHECK(coins.min_coins(p) <= game.get_all_players()[p]->get_coins());
+        CHECK(game.get_all_players()[p]->get_coins() <= coins.max_coins(p));
+    }
+    CHECK(coins.min_coins(0) == coins.max_coins(0)); // The observer's own count
+    coins.set_bounds(2, game.get_all_players()[2]->get_coins(), game.get_all_players()[2]->get_coins());
+
+    InfoSetView view(game, coins);
+    GameState sample;
+    for (int i = 0; i < 50; ++i)
+    {
+        view.determinize(sample, rng);
+        for (PlayerId p = 0; p < 3; ++p)
+        {
+            CHECK(sample.players[p].coins >= view.min_coins(p));
+            CHECK(sample.players[p].coins <= view.max_coins(p));
+        }
+        CHECK(sample.players[0].coins == game.get_all_players()[0]->get_coins());
+        CHECK(sample.players[2].coins == game.get_all_players()[2]->get_coins());
+        CHECK(sample.hash == hash_state(sample));
+    }
+}
+
+TEST_CASE("determinize spreads over the counts an opponent may hold")
+{
+    Game game;
+    auto governor = create_player(game, "Governor", "A");
+    auto merchant = create_player(game, "Merchant", "B");
+    auto judge = create_player(game, "Judge", "C");
+    game.add_player(governor);
+    game.add_player(merchant);
+    game.add_player(judge);
+    CoinTracker coins;
+    coins.sync(game, governor->get_id()); // At the deal
+    governor->gather();
+    merchant->tax(); // 2 coins, but a tax may bring 3 for all the Governor knows
+    judge->tax();
+    coins.sync(game, governor->get_id());
+
+    InfoSetView view(game, coins);
+    SimRng rng(9);
+    GameState sample;
+    std::vector<std::vector<int>> seen;
+    for (int i = 0; i < 50; ++i)
+    {
+        view.determinize(sample, rng);
+        std::vector<int> counts;
+        for (PlayerId p = 0; p < sample.player_count; ++p)
+            counts.push_back(sample.players[p].coins);
+        if (std::find(seen.begin(), seen.end(), counts) == seen.end())
+            seen.push_back(counts);
+    }
+    CHECK(seen.size() == 4); // Merchant and Judge each hold 2 or 3
+    for (const std::vector<int> &counts : seen)
+        CHECK(counts[0] == 1);
+}
+
+TEST_CASE("InfoSetView lists the moves the observer may play on the counts it knows")
+{
+    Game game;
+    auto governor = create_player(game, "Governor", "A");
+    auto merchant = create_player(game, "Merchant", "B");
+    auto judge = create_player(game, "Judge", "C");
+    game.add_player(governor);
+    game.add_player(merchant);
+    game.add_player(judge);
+    governor->gather();
+    merchant->gather();
+    judge->gather();
+    CoinTracker coins;
+    coins.sync(game, governor->get_id());
+    InfoSetView view(game, coins);
+    CHECK_FALSE(view.legal_actions().allows(ActionKind::Arrest, merchant->get_id())); // 1 coin, a Merchant needs 2
+
+    coins.set_bounds(merchant->get_id(), 1, 3); // A position the Governor only partly knows
+    ActionSet legal = view.legal_actions();
+    CHECK_FALSE(game.legal_actions(governor->get_id()).allows(ActionKind::Arrest, merchant->get_id()));
+    CHECK(legal.allows(ActionKind::Arrest, merchant->get_id())); // The rules would have told the count
+    game.legal_actions(governor->get_id()).for_each(governor->get_id(), [&](const Action &move) {
+        CHECK(legal.allows(move.kind, move.target));
+    });
+}
+
+TEST_CASE("Game::unmake retracts every legal move in place without allocating")
+{
+    Game game;
+    const char *roles[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+    for (const char *role : roles)
+        game.add_player(create_player(game, role, role));
+    game.enable_journal(64);
+    GameState root;
+    std::memcpy(&root, &game.get_state(), sizeof(GameState));
+    const JournalMark start = game.mark();
+
+    std::size_t reserved = 0;
+    for (int pass = 0; pass < 2; ++pass) // The first pass warms the journal up, the second must not allocate
+    {
+        SimRng rng(11);
+        std::size_t tried = 0;
+        for (int ply = 0; ply < 300 && !game.is_game_over(); ++ply)
+        {
+            GameState before;
+            std::memcpy(&before, &game.get_state(), sizeof(GameState));
+            const JournalMark mark = game.mark();
+            const std::size_t logged = game.get_history().size();
+            HistoryEntry newest{};
+            if (logged > 0)
+                newest = game.get_history().back();
+            std::vector<Action> moves;
+            for (PlayerId p = 0; p < 6; ++p)
+                game.legal_actions(p).for_each(p, [&moves](const Action &action) { moves.push_back(action); });
+            for (const Action &move : moves) // Make and unmake every move, out-of-turn reactions included
+            {
+                REQUIRE(SimEngine::apply(game, move));
+                game.unmake(mark);
+                CHECK(std::memcmp(&game.get_state(), &before, sizeof(GameState)) == 0);
+                CHECK(game.get_history().size() == logged); // The action is taken back from the log too
+                CHECK(game.get_history().total_pushed() == mark.actions);
+                if (logged > 0)
+                {
+                    const HistoryEntry &back = game.get_history().back();
+                    CHECK((back.kind == newest.kind && back.actor == newest.actor && back.target == newest.target &&
+                           back.amount == newest.amount && back.turn == newest.turn));
+                }
+                ++tried;
+            }
+            if (moves.empty())
+                game.pass_turn();
+            else
+                SimEngine::apply(game, moves[rng() % moves.size()]);
+        }
+        CHECK(tried > 200);
+        CHECK(game.get_journal().size() > 0);
+        if (pass == 1)
+            CHECK(game.get_journal().capacity() == reserved);
+        reserved = game.get_journal().capacity();
+
+        game.unmake(start); // Back to the deal in one step
+        CHECK(std::memcmp(&game.get_state(), &root, sizeof(GameState)) == 0);
+        CHECK(game.get_history().empty());
+        CHECK(game.get_journal().size() == 0);
+    }
+
+    const JournalMark stale{1, 0};
+    CHECK_THROWS_AS(game.unmake(stale), StateMismatchException);
+}
+
+TEST_CASE("IsmctsSearch finds a winning coup and plays full games")
+{
+    Game game;
+    auto a = create_player(game, "Baron", "A");
+    auto b = create_player(game, "Spy", "B");
+    auto c = create_player(game, "Governor", "C");
+    game.add_player(a);
+    game.add_player(b);
+    game.add_player(c);
+    c->mark_eliminated();
+    a->increase_coins(7);
+    b->increase_coins(7);
+    // Both counts were set up off the record; the search takes them as known
+    const std::uint64_t before = game.get_hash();
+
+    for (std::size_t threads : {1, 3})
+    {
+        MctsConfig config;
+        config.threads = threads;
+        config.playouts = 400;
+        IsmctsSearch search(config);
+        for (std::uint64_t seed : {1, 2}) // The second search reuses the workers
+        {
+            Action best = search.search(game, a->get_id(), seed);
+            CHECK(best.kind == ActionKind::Coup);
+            CHECK(best.target == b->get_id());
+            CHECK(search.last_stats().playouts == 400);
+        }
+    }
+    CHECK(game.get_hash() == before);
+
+    SimConfig sim;
+    sim.games = 3;
+    sim.players = 4;
+    SimEngine engine(sim);
+    MctsConfig quick;
+    quick.playouts = 50;
+    auto bot = std::make_shared<IsmctsStrategy>(quick);
+    engine.set_strategy(0, bot);
+    SimStats stats = engine.run();
+    CHECK(stats.games == 3);
+    CHECK(bot->total_stats().searches > 0);
+}
+
+TEST_CASE("WorkStealingPool runs every task once and rebalances uneven work")
+{
+    WorkStealingPool pool(4);
+    CHECK(pool.size() == 4);
+
+    std::vector<std::atomic<int>> runs(1000);
+    std::vector<std::atomic<int>> by_worker(pool.size());
+    pool.run(runs.size(), [&](std::size_t worker, std::size_t task) {
+        runs[task]++;
+        by_worker[worker]++;
+        if (task < 250) // All the slow tasks start on worker 0
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    });
+    for (std::atomic<int> &count : runs)
+        CHECK(count == 1);
+    CHECK(pool.steals() > 0);
+
+    pool.run(0, [](std::size_t, std::size_t) {}); // Nothing to do
+    CHECK_THROWS_AS(pool.run(10, [](std::size_t, std::size_t task) {
+        if (task == 7)
+            throw std::runtime_error("task failed");
+    }),
+                    std::runtime_error);
+    std::atomic<int> after{0};
+    pool.run(5, [&after](std::size_t, std::size_t) { ++after; }); // Still usable after a failure
+    CHECK(after == 5);
+}
+
+TEST_CASE("SimEngine pooled batches do not depend on the number of workers")
+{
+    SimConfig config;
+    config.games = 300;
+    config.players = 4;
+    config.seed = 11;
+    SimStats reference;
+    for (std::size_t threads : {1, 2, 5})
+    {
+        SimEngine engine(config);
+        engine.set_strategy(1, std::make_shared<GreedyStrategy>());
+        WorkStealingPool pool(threads);
+        SimStats stats = engine.run(pool);
+        CHECK(stats.games == 300);
+        if (threads == 1)
+            reference = stats;
+        CHECK(stats.wins == reference.wins);
+        CHECK(stats.actions == reference.actions);
+        CHECK(stats.draws == reference.draws);
+
+        SimStats again = engine.run(pool); // Workers and their tables are reused
+        CHECK(again.wins == reference.wins);
+    }
+
+    SimEngine serial(config);
+    serial.set_strategy(1, std::make_shared<GreedyStrategy>());
+    SimStats plain = serial.run(); // Per-game streams make the plain loop agree with the pool
+    CHECK(plain.wins == reference.wins);
+    CHECK(plain.actions == reference.actions);
+
+    SimConfig fixed = config; // A fixed roster reuses every table
+    fixed.roles = {"Spy", "Baron", "Judge"};
+    SimEngine engine(fixed);
+    WorkStealingPool one(1), three(3);
+    CHECK(engine.run(one).wins == engine.run(three).wins);
+}
+
+TEST_CASE("CounterRng streams are reproducible, seekable and independent")
+{
+    SimRng a(42), b(42), other(42, 1);
+    std::vector<std::uint64_t> drawn;
+    for (int i = 0; i < 1000; ++i)
+    {
+        drawn.push_back(a());
+        CHECK(drawn.back() == b());
+    }
+    CHECK(a.position() == 1000);
+
+    SimRng jump(42);
+    jump.seek(500);
+    CHECK(jump() == drawn[500]);
+    jump.discard(98);
+    CHECK(jump() == drawn[599]);
+
+    std::size_t same = 0, ones = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::uint64_t value = other();
+        same += value == drawn[i];
+        for (std::uint64_t bits = value; bits; bits &= bits - 1)
+            ++ones;
+    }
+    CHECK(same == 0);
+    CHECK(ones > 31000); // About half of 64000 bits are set
+    CHECK(ones < 33000);
+    CHECK(SimRng(42).split(3)() != SimRng(42).split(4)());
+    CHECK(SimEngine::game_stream(7, 12) == SimRng(7, 12));
+
+    SimRng unit(9);
+    double low = 1, high = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        double x = unit.uniform();
+        low = std::min(low, x);
+        high = std::max(high, x);
+    }
+    CHECK(low >= 0.0);
+    CHECK(low < 0.01);
+    CHECK(high < 1.0);
+    CHECK(high > 0.99);
+}
+
+TEST_CASE("ReplaySink records a game that ReplayReader re-executes and verifies")
+{
+    Game game;
+    auto governor = create_player(game, "Governor", "Gov");
+    auto spy = std::make_shared<Spy>(game, "Spy");
+    auto baron = create_player(game, "Baron", "Baron");
+    game.add_player(governor);
+    game.add_player(spy);
+    game.add_player(baron);
+
+    ReplaySink sink;
+    game.set_event_sink(&sink);
+    sink.begin(game, 77, 3);
+    governor->gather();
+    spy->tax();
+    SimEngine::apply(game, Action{ActionKind::UndoTax, governor->get_id(), kNoTarget}); // Reaction: actor is stored
+    spy->peek_and_disable(baron);
+    baron->gather();
+    game.pass_turn();
+    spy->gather();
+    sink.finish();
+    CHECK(sink.record_count() == 7);
+
+    const std::vector<std::uint8_t> &bytes = sink.bytes();
+    ReplayReader reader(bytes.data(), bytes.size());
+    Game copy;
+    ReplayInfo info = reader.next(copy);
+    CHECK(reader.done());
+    CHECK(info.seed == 77);
+    CHECK(info.stream == 3);
+    CHECK(info.names == std::vector<std::string>{"Gov", "Spy", "Baron"});
+    CHECK(info.roles[2] == RoleId::Baron);
+    CHECK(info.records == 7);
+    CHECK(info.bytes == bytes.size());
+    CHECK(copy.get_hash() == game.get_hash());
+    CHECK(copy.get_all_players()[1]->get_coins() == spy->get_coins());
+
+    std::vector<std::uint8_t> changed = bytes;
+    changed[changed.size() - 6] ^= 1; // Top byte of the final hash (followed by the empty index and its length)
+    Game other;
+    CHECK_THROWS_AS(ReplayReader(changed.data(), changed.size()).next(other), ReplayMismatchException);
+    Game cut;
+    CHECK_THROWS_AS(ReplayReader(bytes.data(), bytes.size() - 5).next(cut), ReplayFormatException);
+}
+
+TEST_CASE("Keyframes store rule fields, not struct bytes")
+{
+    Game game;
+    const char *roles[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+    for (const char *role : roles)
+        game.add_player(create_player(game, role, role));
+    const GameState base = game.get_state();
+    std::vector<std::uint8_t> bytes;
+    replay::put_state(bytes, base, base);
+    CHECK(bytes.size() == 2); // One run of 73 unchanged fields: varint 73, varint 0
+
+    SimRng rng(11);
+    RandomStrategy bot;
+    for (int ply = 0; ply < 40 && !game.is_game_over(); ++ply)
+    {
+        PlayerId actor = static_cast<PlayerId>(game.get_turn_index());
+        if (!SimEngine::apply(game, bot.choose_action(game, actor, rng)))
+            game.pass_turn();
+    }
+    bytes.clear();
+    replay::put_state(bytes, game.get_state(), base);
+    GameState decoded;
+    const std::uint8_t *at = bytes.data();
+    replay::get_state(at, bytes.data() + bytes.size(), base, decoded);
+    CHECK(at == bytes.data() + bytes.size());
+
+    std::uint64_t want[replay::kMaxStateFields], got[replay::kMaxStateFields];
+    REQUIRE(replay::state_fields(decoded, got) == replay::kStateFields + 6 * replay::kSeatFields);
+    replay::state_fields(game.get_state(), want);
+    CHECK(std::equal(want, want + replay::kStateFields + 6 * replay::kSeatFields, got));
+    CHECK(decoded.hash == game.get_hash());
+    CHECK(decoded.abilities_used == game.get_state().abilities_used);
+    for (PlayerId i = 0; i < 6; ++i)
+        CHECK(decoded.players[i].coups_by == game.get_state().players[i].coups_by);
+
+    bytes = {2, 1, 9, 70, 0}; // Turn index 9 on a 6-seat table
+    at = bytes.data();
+    CHECK_THROWS_AS(replay::get_state(at, bytes.data() + bytes.size(), base, decoded), ReplayFormatException);
+}
+
+TEST_CASE("ReplayReader reads older versions and steps over their keyframes")
+{
+    SimConfig config;
+    config.games = 1;
+    config.players = 4;
+    config.seed = 9;
+    std::ostringstream indexed, plain;
+    {
+        ReplayWriter with_keyframes(indexed), without(plain);
+        SimEngine engine(config);
+        engine.record_to(&with_keyframes, 8);
+        engine.run();
+        engine.record_to(&without, 0);
+        engine.run();
+    }
+    const std::string a = indexed.str(), b = plain.str();
+    std::vector<std::uint8_t> current(a.begin(), a.end());
+    REQUIRE(current[2] == replay::kVersion);
+    Game reference;
+    const ReplayInfo expected = ReplayReader(current.data(), current.size()).next(reference);
+
+    std::vector<std::uint8_t> v2 = current;
+    v2[2] = 2;
+    REQUIRE_FALSE(ReplaySeeker(current).get_keyframes().empty());
+    v2[ReplaySeeker(current).get_keyframes()[0].offset + 3] ^= 0xFF; // Stands in for another layout: never decoded
+    std::vector<std::uint8_t> v1(b.begin(), b.end() - 5); // No index: drop the empty one and its length
+    v1[2] = 1;
+
+    for (const std::vector<std::uint8_t> *old : {&v2, &v1})
+    {
+        Game game;
+        ReplayInfo info = ReplayReader(old->data(), old->size()).next(game);
+        CHECK(info.version == (*old)[2]);
+        CHECK(info.records == expected.records);
+        CHECK(info.hash == expected.hash);
+        CHECK(info.bytes == old->size());
+
+        ReplayReader reader(old->data(), old->size());
+        ReplaySpan span = reader.skip();
+        CHECK(reader.done());
+        ReplaySeeker seeker(span);
+        CHECK(seeker.get_keyframes().empty()); // Nothing usable: seeks replay from the start
+        CHECK(seeker.info().records == expected.records);
+        Game sought;
+        CHECK(seeker.seek(sought, expected.records) == expected.records);
+        CHECK(sought.get_hash() == expected.hash);
+    }
+
+    for (std::uint8_t version : {0, replay::kVersion + 1})
+    {
+        std::vector<std::uint8_t> unknown = current;
+        unknown[2] = version;
+        Game game;
+        CHECK_THROWS_AS(ReplayReader(unknown.data(), unknown.size()).next(game), ReplayFormatException);
+        CHECK_THROWS_AS(ReplaySeeker{unknown}, ReplayFormatException);
+    }
+}
+
+TEST_CASE("SimEngine records every batch game in under 2 bytes per move")
+{
+    SimConfig config;
+    config.games = 200;
+    config.players = 6;
+    config.seed = 5;
+    std::ostringstream log;
+    SimStats stats;
+    {
+        ReplayWriter writer(log);
+        SimEngine engine(config);
+        engine.set_strategy(1, std::make_shared<GreedyStrategy>());
+        engine.record_to(&writer);
+        WorkStealingPool pool(3);
+        stats = engine.run(pool);
+        writer.close();
+        CHECK(writer.replays_written() == 200);
+        CHECK(writer.bytes_written() == log.str().size());
+    }
+
+    const std::string data = log.str();
+    ReplayReader reader(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
+    std::vector<bool> seen(config.games, false);
+    std::uint64_t records = 0;
+    std::size_t wins = 0;
+    while (!reader.done())
+    {
+        Game game;
+        ReplayInfo info = reader.next(game);
+        CHECK(info.seed == 5);
+        REQUIRE(info.stream < config.games);
+        CHECK_FALSE(seen[info.stream]);
+        seen[info.stream] = true;
+        records += info.records;
+        wins += game.is_game_over() && game.get_winner() == 1;
+    }
+    CHECK(std::count(seen.begin(), seen.end(), true) == 200);
+    CHECK(wins == stats.wins[1]);
+    CHECK(records >= stats.actions); // Passes are recorded too
+    CHECK(static_cast<double>(data.size()) / records < 2.0);
+}
+
+TEST_CASE("SimEngine plays and records tables of up to 64 players")
+{
+    for (std::size_t players : {16, 64})
+    {
+        SimConfig config;
+        config.games = 4;
+        config.players = players;
+        config.max_turns = players * 200;
+        std::ostringstream log;
+        SimStats stats;
+        {
+            ReplayWriter writer(log);
+            SimEngine engine(config);
+            engine.record_to(&writer);
+            stats = engine.run();
+            writer.close();
+        }
+        CHECK(stats.games == 4);
+
+        const std::string data = log.str();
+        ReplayReader reader(reinterpret_cast<const std::uint8_t *>(data.data()), data.size());
+        std::size_t replayed = 0;
+        while (!reader.done())
+        {
+            Game game; // Replays grow the default table to the recorded size
+            ReplayInfo info = reader.next(game);
+            CHECK(info.roles.size() == players);
+            CHECK(game.get_hash() == hash_state(game.get_state()));
+            ++replayed;
+        }
+        CHECK(replayed == 4);
+    }
+}
+
+TEST_CASE("ReplaySeeker jumps to any move through the keyframe index")
+{
+    SimConfig config;
+    config.games = 4;
+    config.players = 5;
+    config.seed = 21;
+    std::ostringstream indexed, plain;
+    {
+        ReplayWriter with_keyframes(indexed), without(plain);
+        SimEngine engine(config);
+        engine.record_to(&with_keyframes, 16);
+        engine.run();
+        engine.record_to(&without, 0); // The same games again, with no keyframes
+        engine.run();
+    }
+
+    const std::string a = indexed.str(), b = plain.str();
+    ReplayReader fast(reinterpret_cast<const std::uint8_t *>(a.data()), a.size());
+    ReplayReader slow(reinterpret_cast<const std::uint8_t *>(b.data()), b.size());
+    ReplayReader verify(reinterpret_cast<const std::uint8_t *>(a.data()), a.size());
+    std::size_t games = 0;
+    while (!fast.done())
+    {
+        Game checked;
+        ReplayInfo full = verify.next(checked); // Keyframes are checked against the replayed game
+        ReplaySeeker seeker(fast.skip());
+        ReplaySeeker reference(slow.skip());
+        CHECK(seeker.info().records == full.records);
+        CHECK(seeker.info().hash == full.hash);
+        CHECK(reference.get_keyframes().empty());
+        CHECK(seeker.get_keyframes().size() >= (full.records - 1) / 16);
+
+        Game jumped, walked;
+        for (std::uint64_t record = 0; record <= full.records; record += 7)
+        {
+            CHECK(seeker.seek(jumped, record) < 16 + 16); // Keyframes fall between turns, at most a turn late
+            reference.seek(walked, record);
+            CHECK(jumped.get_hash() == walked.get_hash());
+        }
+        seeker.seek(jumped, full.records);
+        CHECK(jumped.get_hash() == full.hash);
+        CHECK_THROWS_AS(seeker.seek(jumped, full.records + 1), std::out_of_range);
+        games++;
+    }
+    CHECK(slow.done());
+    CHECK(games == 4);
+}